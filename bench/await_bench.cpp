@@ -0,0 +1,242 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 Jettison Project Team
+
+// Per-message overhead of StateStream (co_await) versus a raw subscriber
+// callback. Frames are injected with Receiver::process_payload, so no
+// network or server is needed.
+//
+// Usage: jettison_rx_bench [dump_file] [iterations]
+
+#include "dump_manager.h"
+#include "receiver.h"
+#include "state_stream.h"
+#include <chrono>
+#include <coroutine>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace jettison;
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * @brief Minimal eagerly-started coroutine owning its frame
+ */
+struct Consumer
+{
+  struct promise_type
+  {
+    Consumer
+    get_return_object ()
+    {
+      return Consumer{ std::coroutine_handle<promise_type>::from_promise (
+          *this) };
+    }
+    std::suspend_never initial_suspend () noexcept { return {}; }
+    std::suspend_always final_suspend () noexcept { return {}; }
+    void return_void () noexcept {}
+    void unhandled_exception () { std::terminate (); }
+  };
+
+  explicit Consumer (std::coroutine_handle<promise_type> h) : handle (h) {}
+  Consumer (const Consumer &) = delete;
+  Consumer &operator= (const Consumer &) = delete;
+  ~Consumer ()
+  {
+    if (handle)
+      {
+        handle.destroy ();
+      }
+  }
+
+  std::coroutine_handle<promise_type> handle;
+};
+
+struct Tally
+{
+  uint64_t count = 0;
+  uint64_t sum = 0;
+};
+
+Consumer
+consume (StateStream &stream, Tally &tally)
+{
+  while (const StateEvent *event = co_await stream.next_state ())
+    {
+      tally.count++;
+      tally.sum += event->sequence;
+    }
+}
+
+double
+ns_per (Clock::duration elapsed, uint64_t iterations)
+{
+  return static_cast<double> (
+             std::chrono::duration_cast<std::chrono::nanoseconds> (elapsed)
+                 .count ())
+         / static_cast<double> (iterations);
+}
+
+ReceiverOptions
+bench_options ()
+{
+  ReceiverOptions options;
+  Endpoint endpoint;
+  endpoint.host = "bench";
+  options.endpoints.push_back (endpoint);
+  return options;
+}
+
+void
+report (const char *name, double callback_ns, double await_ns,
+        const Tally &a, const Tally &b)
+{
+  std::cout << name << ": callback " << callback_ns << " ns/msg, co_await "
+            << await_ns << " ns/msg (delta " << await_ns - callback_ns
+            << " ns)  [" << a.count << "/" << b.count << " delivered, sums "
+            << (a.sum == b.sum ? "match" : "DIFFER") << "]\n";
+}
+
+/**
+ * @brief Delivery only: a prebuilt event pushed N times
+ */
+void
+bench_delivery (const std::vector<uint8_t> &payload, uint64_t iterations)
+{
+  Receiver receiver (bench_options ());
+  const ValidationResult result{ true, {}, {} };
+  ser::JonGUIState state;
+
+  Tally by_callback;
+  std::function<void (const StateEvent &)> callback
+      = [&by_callback] (const StateEvent &event) {
+          by_callback.count++;
+          by_callback.sum += event.sequence;
+        };
+
+  auto start = Clock::now ();
+  for (uint64_t i = 1; i <= iterations; ++i)
+    {
+      const StateEvent event{ 0,      receiver.endpoints ()[0],
+                              i,      payload.data (),
+                              payload.size (), &state,
+                              result, Clock::time_point{},
+                              FrameOrder::New };
+      callback (event);
+    }
+  const double callback_ns = ns_per (Clock::now () - start, iterations);
+
+  Tally by_await;
+  StateStream stream (receiver);
+  Consumer consumer = consume (stream, by_await);
+
+  start = Clock::now ();
+  for (uint64_t i = 1; i <= iterations; ++i)
+    {
+      const StateEvent event{ 0,      receiver.endpoints ()[0],
+                              i,      payload.data (),
+                              payload.size (), &state,
+                              result, Clock::time_point{},
+                              FrameOrder::New };
+      stream.push (event);
+    }
+  const double await_ns = ns_per (Clock::now () - start, iterations);
+  stream.close ();
+
+  report ("delivery only ", callback_ns, await_ns, by_callback, by_await);
+}
+
+/**
+ * @brief Full pipeline: parse + validate + deliver through a Receiver
+ */
+void
+bench_pipeline (const std::vector<uint8_t> &payload, uint64_t iterations)
+{
+  Tally by_callback;
+  Receiver callback_receiver (bench_options ());
+  callback_receiver.subscribe ([&by_callback] (const StateEvent &event) {
+    by_callback.count++;
+    by_callback.sum += event.sequence;
+  });
+
+  auto start = Clock::now ();
+  for (uint64_t i = 0; i < iterations; ++i)
+    {
+      callback_receiver.process_payload (0, payload.data (), payload.size ());
+    }
+  const double callback_ns = ns_per (Clock::now () - start, iterations);
+
+  Tally by_await;
+  Receiver await_receiver (bench_options ());
+  StateStream stream (await_receiver);
+  Consumer consumer = consume (stream, by_await);
+
+  start = Clock::now ();
+  for (uint64_t i = 0; i < iterations; ++i)
+    {
+      await_receiver.process_payload (0, payload.data (), payload.size ());
+    }
+  const double await_ns = ns_per (Clock::now () - start, iterations);
+  stream.close ();
+
+  report ("full pipeline ", callback_ns, await_ns, by_callback, by_await);
+}
+
+} // namespace
+
+int
+main (int argc, char *argv[])
+{
+  std::vector<uint8_t> payload;
+  if (argc > 1)
+    {
+      DumpManager dump_manager;
+      payload = dump_manager.read_dump (argv[1]);
+      if (payload.empty ())
+        {
+          std::cerr << "Failed to read dump file or file is empty\n";
+          return EXIT_FAILURE;
+        }
+    }
+  else
+    {
+      ser::JonGUIState state;
+      state.set_protocol_version (1);
+      const std::string bytes = state.SerializeAsString ();
+      payload.assign (bytes.begin (), bytes.end ());
+    }
+
+  uint64_t iterations = 100000;
+  if (argc > 2)
+    {
+      try
+        {
+          iterations = std::stoull (argv[2]);
+        }
+      catch (...)
+        {
+          std::cerr << "Error: invalid iteration count\n";
+          return EXIT_FAILURE;
+        }
+    }
+  if (iterations == 0)
+    {
+      std::cerr << "Error: iteration count must be positive\n";
+      return EXIT_FAILURE;
+    }
+
+  std::cout << "Payload: " << payload.size () << " bytes, " << iterations
+            << " iterations\n";
+  bench_delivery (payload, iterations * 100);
+  bench_pipeline (payload, iterations);
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,252 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 Jettison Project Team
+
+// Synthetic JonGUIState generator with controlled corruption. Measures
+// generation and ProtoValidator throughput at a chosen valid/invalid mix
+// in memory, or writes the frames out as a dump corpus.
+//
+// Usage: jettison_state_gen [--count N] [--seed S] [--base DUMP]
+//                           [--out-of-range F] [--missing F]
+//                           [--truncated F] [--bad-tag F]
+//                           [--validate] [--write DIR]
+
+#include "dump_manager.h"
+#include "proto_validator.h"
+#include "state_generator.h"
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace jettison;
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+constexpr size_t KINDS = 5;
+
+/**
+ * @brief Outcome counters per corruption kind
+ */
+struct Tally
+{
+  uint64_t frames = 0;
+  uint64_t parsed = 0;
+  uint64_t valid = 0;
+};
+
+void
+print_usage (const char *program_name)
+{
+  std::cout << "Usage: " << program_name << " [options]\n\n"
+            << "Options:\n"
+            << "  --count N         Frames to generate (default 1000000)\n"
+            << "  --seed S          Random seed (default 1)\n"
+            << "  --base DUMP       Template message (default: built-in)\n"
+            << "  --out-of-range F  Fraction with a field out of range\n"
+            << "  --missing F       Fraction missing a sub-message\n"
+            << "  --truncated F     Fraction cut short\n"
+            << "  --bad-tag F       Fraction with an invalid tag\n"
+            << "  --validate        Parse and validate every frame\n"
+            << "  --write DIR       Write frames as DIR/state_NNNN.bin\n";
+}
+
+double
+per_second (uint64_t count, Clock::duration elapsed)
+{
+  return static_cast<double> (count)
+         / std::max (std::chrono::duration<double> (elapsed).count (), 1e-9);
+}
+
+} // namespace
+
+int
+main (int argc, char *argv[])
+{
+  uint64_t count = 1000000;
+  uint64_t seed = 1;
+  std::string base_file;
+  std::string write_dir;
+  bool validate = false;
+  StateGenerator::Mix mix;
+
+  for (int i = 1; i < argc; ++i)
+    {
+      const std::string arg = argv[i];
+      if (arg == "--validate")
+        {
+          validate = true;
+          continue;
+        }
+      if (arg == "-h" || arg == "--help" || i + 1 >= argc)
+        {
+          print_usage (argv[0]);
+          return arg == "-h" || arg == "--help" ? EXIT_SUCCESS
+                                                : EXIT_FAILURE;
+        }
+      const std::string value = argv[++i];
+      try
+        {
+          if (arg == "--count")
+            {
+              count = std::stoull (value);
+            }
+          else if (arg == "--seed")
+            {
+              seed = std::stoull (value);
+            }
+          else if (arg == "--base")
+            {
+              base_file = value;
+            }
+          else if (arg == "--write")
+            {
+              write_dir = value;
+            }
+          else if (arg == "--out-of-range")
+            {
+              mix.out_of_range = std::stod (value);
+            }
+          else if (arg == "--missing")
+            {
+              mix.missing = std::stod (value);
+            }
+          else if (arg == "--truncated")
+            {
+              mix.truncated = std::stod (value);
+            }
+          else if (arg == "--bad-tag")
+            {
+              mix.bad_tag = std::stod (value);
+            }
+          else
+            {
+              std::cerr << "Error: unknown argument '" << arg << "'\n\n";
+              print_usage (argv[0]);
+              return EXIT_FAILURE;
+            }
+        }
+      catch (...)
+        {
+          std::cerr << "Error: invalid value for " << arg << "\n";
+          return EXIT_FAILURE;
+        }
+    }
+
+  if (mix.out_of_range + mix.missing + mix.truncated + mix.bad_tag > 1.0)
+    {
+      std::cerr << "Error: corruption fractions add up to more than 1\n";
+      return EXIT_FAILURE;
+    }
+
+  ser::JonGUIState base;
+  if (!base_file.empty ())
+    {
+      DumpManager dump_manager;
+      const auto data = dump_manager.read_dump (base_file);
+      if (data.empty ()
+          || !base.ParseFromArray (data.data (), static_cast<int> (data.size ())))
+        {
+          std::cerr << "Error: cannot use " << base_file << " as base\n";
+          return EXIT_FAILURE;
+        }
+    }
+
+  const auto setup_start = Clock::now ();
+  StateGenerator generator (mix, seed, base_file.empty () ? nullptr : &base);
+  std::cout << "Pool built in "
+            << std::chrono::duration_cast<std::chrono::milliseconds> (
+                   Clock::now () - setup_start)
+                   .count ()
+            << " ms\n";
+
+  // Generation alone, into one reused buffer
+  std::vector<uint8_t> payload;
+  uint64_t bytes = 0;
+  auto start = Clock::now ();
+  for (uint64_t i = 0; i < count; ++i)
+    {
+      generator.next (payload);
+      bytes += payload.size ();
+    }
+  const auto generate_time = Clock::now () - start;
+  std::cout << std::fixed << std::setprecision (2) << "Generated " << count
+            << " frames (" << bytes / std::max<uint64_t> (count, 1)
+            << " B avg): " << per_second (count, generate_time) / 1e6
+            << " M frames/s\n";
+
+  if (!write_dir.empty ())
+    {
+      DumpManager dump_manager (write_dir);
+      if (!dump_manager.ensure_dump_dir_exists ())
+        {
+          std::cerr << "Error: cannot create " << write_dir << "\n";
+          return EXIT_FAILURE;
+        }
+      StateGenerator corpus (mix, seed, base_file.empty () ? nullptr : &base);
+      for (uint64_t i = 0; i < count; ++i)
+        {
+          corpus.next (payload);
+          if (!dump_manager.save_dump (payload.data (), payload.size (),
+                                       static_cast<int> (i + 1)))
+            {
+              return EXIT_FAILURE;
+            }
+        }
+      std::cout << "Wrote " << count << " dumps to " << write_dir << "\n";
+    }
+
+  if (!validate)
+    {
+      return EXIT_SUCCESS;
+    }
+
+  // Same sequence again, through the real parse + validate path
+  StateGenerator replay (mix, seed, base_file.empty () ? nullptr : &base);
+  ProtoValidator validator;
+  ser::JonGUIState state;
+  std::array<Tally, KINDS> tallies{};
+  Clock::duration validate_time{};
+  for (uint64_t i = 0; i < count; ++i)
+    {
+      const Corruption kind = replay.next (payload);
+      const auto t0 = Clock::now ();
+      const bool parsed
+          = validator.parse_and_validate (payload.data (), payload.size (),
+                                          state);
+      validate_time += Clock::now () - t0;
+
+      Tally &tally = tallies[static_cast<size_t> (kind)];
+      tally.frames++;
+      tally.parsed += parsed ? 1 : 0;
+      tally.valid += parsed && validator.get_last_result ().is_valid ? 1 : 0;
+    }
+
+  std::cout << "Validated: " << per_second (count, validate_time) / 1e3
+            << " k frames/s ("
+            << std::chrono::duration<double, std::micro> (validate_time)
+                       .count ()
+                   / static_cast<double> (std::max<uint64_t> (count, 1))
+            << " us/frame)\n";
+  std::cout << "  kind           frames     parsed      valid\n";
+  for (size_t k = 0; k < KINDS; ++k)
+    {
+      const Tally &tally = tallies[k];
+      if (tally.frames == 0)
+        {
+          continue;
+        }
+      std::cout << "  " << std::left << std::setw (12)
+                << corruption_name (static_cast<Corruption> (k)) << std::right
+                << std::setw (9) << tally.frames << std::setw (11)
+                << tally.parsed << std::setw (11) << tally.valid << "\n";
+    }
+
+  return EXIT_SUCCESS;
+}
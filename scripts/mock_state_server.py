@@ -0,0 +1,172 @@
+#!/usr/bin/env python3
+"""
+Local stand-in for the Jettison state WebSocket endpoint.
+
+Serves captured dump files (dumps/state_*.bin) as binary WebSocket
+messages over plain ws://, looping over the files at a fixed rate. It can
+listen on a range of ports so one process can simulate a whole fleet for
+--hosts/--hosts-file testing. Uses only the Python standard library.
+
+Usage:
+    python3 scripts/mock_state_server.py [--dumps DIR] [--port P]
+                                         [--count N] [--rate HZ]
+                                         [--deflate]
+
+With --deflate, permessage-deflate (RFC 7692) is accepted when the client
+offers it, honouring server_max_window_bits and server_no_context_takeover.
+
+Example (simulate 100 devices on ports 8765..8864 at 30 Hz):
+    python3 scripts/mock_state_server.py --count 100 --rate 30
+    seq 8765 8864 | sed 's#^#ws://127.0.0.1:#' > fleet.txt
+    ./jettison_state_rx --hosts-file fleet.txt --workers 2 --rate 1
+"""
+
+import argparse
+import asyncio
+import base64
+import glob
+import hashlib
+import os
+import struct
+import sys
+import zlib
+
+WS_GUID = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11"
+
+
+def ws_frame(payload, opcode=0x2, rsv1=False):
+    """Encode an unmasked server-to-client WebSocket frame."""
+    header = bytes([0x80 | (0x40 if rsv1 else 0) | opcode])
+    n = len(payload)
+    if n < 126:
+        header += bytes([n])
+    elif n < 65536:
+        header += bytes([126]) + struct.pack("!H", n)
+    else:
+        header += bytes([127]) + struct.pack("!Q", n)
+    return header + payload
+
+
+def negotiate_deflate(offer):
+    """Return (response header value, window bits, no_context_takeover)."""
+    params = {}
+    for part in offer.split(";")[1:]:
+        name, _, value = part.strip().partition("=")
+        params[name] = value
+    bits = int(params.get("server_max_window_bits") or 15)
+    takeover = "server_no_context_takeover" not in params
+    response = "permessage-deflate"
+    if "server_max_window_bits" in params:
+        response += f"; server_max_window_bits={bits}"
+    if not takeover:
+        response += "; server_no_context_takeover"
+    return response, bits, takeover
+
+
+class Deflater:
+    """permessage-deflate message compressor."""
+
+    def __init__(self, bits, takeover):
+        self.bits = bits
+        self.takeover = takeover
+        self.obj = None
+
+    def compress(self, payload):
+        if self.obj is None or not self.takeover:
+            self.obj = zlib.compressobj(wbits=-self.bits)
+        data = self.obj.compress(payload) + self.obj.flush(zlib.Z_SYNC_FLUSH)
+        return data[:-4]  # strip the 00 00 ff ff sync marker
+
+
+async def handle(reader, writer, payloads, interval, allow_deflate):
+    peer = writer.get_extra_info("peername")
+    try:
+        request = await reader.readuntil(b"\r\n\r\n")
+        key = None
+        offer = None
+        for line in request.decode("latin-1").split("\r\n"):
+            name, _, value = line.partition(":")
+            if name.lower() == "sec-websocket-key":
+                key = value.strip()
+            elif (name.lower() == "sec-websocket-extensions"
+                  and "permessage-deflate" in value):
+                offer = value.strip()
+        if key is None:
+            writer.close()
+            return
+
+        accept = base64.b64encode(
+            hashlib.sha1((key + WS_GUID).encode()).digest()).decode()
+        extension = ""
+        deflater = None
+        if allow_deflate and offer:
+            response, bits, takeover = negotiate_deflate(offer)
+            extension = f"Sec-WebSocket-Extensions: {response}\r\n"
+            deflater = Deflater(bits, takeover)
+        writer.write(("HTTP/1.1 101 Switching Protocols\r\n"
+                      "Upgrade: websocket\r\n"
+                      "Connection: Upgrade\r\n"
+                      f"Sec-WebSocket-Accept: {accept}\r\n"
+                      f"{extension}"
+                      "Sec-WebSocket-Protocol: binary\r\n\r\n").encode())
+        await writer.drain()
+
+        index = 0
+        while True:
+            payload = payloads[index % len(payloads)]
+            if deflater:
+                writer.write(ws_frame(deflater.compress(payload), rsv1=True))
+            else:
+                writer.write(ws_frame(payload))
+            await writer.drain()
+            index += 1
+            await asyncio.sleep(interval)
+    except (ConnectionError, asyncio.IncompleteReadError):
+        pass
+    finally:
+        print(f"Client {peer} disconnected")
+        writer.close()
+
+
+async def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[1])
+    parser.add_argument("--dumps", default="dumps",
+                        help="directory with state_*.bin files")
+    parser.add_argument("--host", default="127.0.0.1")
+    parser.add_argument("--port", type=int, default=8765,
+                        help="first port to listen on")
+    parser.add_argument("--count", type=int, default=1,
+                        help="number of consecutive ports (devices)")
+    parser.add_argument("--rate", type=float, default=30.0,
+                        help="messages per second per connection")
+    parser.add_argument("--deflate", action="store_true",
+                        help="accept permessage-deflate if offered")
+    args = parser.parse_args()
+
+    files = sorted(glob.glob(os.path.join(args.dumps, "*.bin")))
+    if not files:
+        print(f"Error: no .bin files in {args.dumps}")
+        sys.exit(1)
+    payloads = []
+    for name in files:
+        with open(name, "rb") as f:
+            payloads.append(f.read())
+
+    interval = 1.0 / args.rate
+    servers = []
+    for port in range(args.port, args.port + args.count):
+        servers.append(await asyncio.start_server(
+            lambda r, w: handle(r, w, payloads, interval, args.deflate),
+            args.host, port))
+
+    print(f"Serving {len(payloads)} payloads at {args.rate} Hz on "
+          f"ws://{args.host}:{args.port}..{args.port + args.count - 1}"
+          f"/ws/ws_state")
+    await asyncio.gather(*(s.serve_forever() for s in servers))
+
+
+if __name__ == "__main__":
+    try:
+        asyncio.run(main())
+    except KeyboardInterrupt:
+        pass
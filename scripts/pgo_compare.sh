@@ -0,0 +1,94 @@
+#!/bin/bash
+# SPDX-License-Identifier: GPL-3.0-or-later
+# Build the default and the profile-guided (PGO+LTO) client and compare
+# their parse/validate/JSON throughput on the same replay corpus
+
+set -e  # Exit on error
+
+# Colors for output
+RED='\033[0;31m'
+GREEN='\033[0;32m'
+BLUE='\033[0;34m'
+NC='\033[0m' # No Color
+
+ROOT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")/.." && pwd)"
+BUILD_ROOT="${ROOT_DIR}/build-pgo"
+CMAKE_FILE=""
+JOBS=$(nproc)
+CORPUS=()
+
+print_usage() {
+    echo "Usage: $0 [OPTIONS] [<dump>...]"
+    echo ""
+    echo "Replays the dumps (or generated frames if none are given) to train"
+    echo "the profile, then through both builds to measure them."
+    echo ""
+    echo "Options:"
+    echo "  --dynamic       Use CMakeLists.txt.dynamic (system dependencies)"
+    echo "  --build-dir D   Parent of the two build directories (default: build-pgo)"
+    echo "  -j, --jobs N    Number of parallel build jobs (default: $(nproc))"
+    echo "  -h, --help      Show this help message"
+}
+
+while [[ $# -gt 0 ]]; do
+    case $1 in
+        --dynamic)
+            CMAKE_FILE="CMakeLists.txt.dynamic"
+            shift
+            ;;
+        --build-dir)
+            BUILD_ROOT="$(realpath -m "$2")"
+            shift 2
+            ;;
+        -j|--jobs)
+            JOBS="$2"
+            shift 2
+            ;;
+        -h|--help)
+            print_usage
+            exit 0
+            ;;
+        -*)
+            echo -e "${RED}Unknown option: $1${NC}"
+            print_usage
+            exit 1
+            ;;
+        *)
+            CORPUS+=("$(realpath "$1")")
+            shift
+            ;;
+    esac
+done
+
+# CMakeLists.txt.dynamic is used from a copy of the tree, as in the Dockerfile
+SOURCE_DIR="${ROOT_DIR}"
+if [ -n "${CMAKE_FILE}" ]; then
+    SOURCE_DIR="${BUILD_ROOT}/src"
+    mkdir -p "${SOURCE_DIR}"
+    cp -r "${ROOT_DIR}/src" "${ROOT_DIR}/bench" "${SOURCE_DIR}/"
+    ln -sfn "${ROOT_DIR}/jettison_proto_cpp" "${SOURCE_DIR}/jettison_proto_cpp"
+    cp "${ROOT_DIR}/${CMAKE_FILE}" "${SOURCE_DIR}/CMakeLists.txt"
+fi
+
+CORPUS_LIST=$(IFS=';'; echo "${CORPUS[*]}")
+CONFIGURE=(-DCMAKE_BUILD_TYPE=Release -DENFORCE_CHECKS=OFF)
+
+echo -e "${BLUE}[1/4] Default build...${NC}"
+cmake -S "${SOURCE_DIR}" -B "${BUILD_ROOT}/default" "${CONFIGURE[@]}" > /dev/null
+cmake --build "${BUILD_ROOT}/default" --target jettison_state_rx -j "${JOBS}"
+
+echo -e "${BLUE}[2/4] Instrumented build and training run...${NC}"
+rm -rf "${BUILD_ROOT}/pgo/pgo"
+cmake -S "${SOURCE_DIR}" -B "${BUILD_ROOT}/pgo" "${CONFIGURE[@]}" \
+    -DJETTISON_RX_PGO=GENERATE "-DJETTISON_RX_PGO_CORPUS=${CORPUS_LIST}" > /dev/null
+cmake --build "${BUILD_ROOT}/pgo" --target pgo-train -j "${JOBS}"
+
+echo -e "${BLUE}[3/4] Profile-guided build...${NC}"
+cmake -S "${SOURCE_DIR}" -B "${BUILD_ROOT}/pgo" -DJETTISON_RX_PGO=USE > /dev/null
+cmake --build "${BUILD_ROOT}/pgo" --target jettison_state_rx -j "${JOBS}"
+
+echo -e "${BLUE}[4/4] Replay...${NC}"
+echo -e "${GREEN}Default:${NC}"
+"${BUILD_ROOT}/default/jettison_state_rx" --replay "${CORPUS[@]}"
+echo -e "${GREEN}PGO+LTO:${NC}"
+"${BUILD_ROOT}/pgo/jettison_state_rx" --replay "${CORPUS[@]}"
@@ -0,0 +1,126 @@
+#!/usr/bin/env python3
+"""
+Load a columnar recording (.jcol) written by `--record` or `--convert-dumps`.
+
+As a module, load_jcol() returns {column name: array}, using numpy arrays
+when numpy is installed (one frombuffer per column chunk, no per-row work)
+and array.array otherwise. As a script, it prints a per-column summary or
+exports selected columns to CSV.
+"""
+
+import argparse
+import array
+import struct
+import sys
+
+try:
+    import numpy as np
+except ImportError:  # pragma: no cover - optional dependency
+    np = None
+
+FILE_MAGIC = b"JCOL0001"
+CHUNK_MAGIC = b"CHNK"
+TYPE_F64 = 0
+TYPE_I64 = 1
+TYPE_U64 = 2
+DTYPES = {TYPE_F64: "<f8", TYPE_I64: "<i8", TYPE_U64: "<u8"}
+TYPECODES = {TYPE_F64: "d", TYPE_I64: "q", TYPE_U64: "Q"}
+
+
+def read_schema(data):
+    """Return ([(name, type)], offset of the first chunk)."""
+    if data[:8] != FILE_MAGIC:
+        raise ValueError("not a JCOL0001 file")
+    (count,) = struct.unpack_from("<I", data, 8)
+    offset = 12
+    columns = []
+    for _ in range(count):
+        (name_len,) = struct.unpack_from("<H", data, offset)
+        offset += 2
+        name = data[offset:offset + name_len].decode("utf-8")
+        offset += name_len
+        columns.append((name, data[offset]))
+        offset += 1
+    return columns, offset
+
+
+def load_jcol(path):
+    """Load every complete chunk of a .jcol file into per-column arrays."""
+    with open(path, "rb") as f:
+        data = f.read()
+
+    columns, offset = read_schema(data)
+    parts = {name: [] for name, _ in columns}
+
+    while offset + 8 <= len(data):
+        if data[offset:offset + 4] != CHUNK_MAGIC:
+            raise ValueError(f"bad chunk header at offset {offset}")
+        (rows,) = struct.unpack_from("<I", data, offset + 4)
+        offset += 8
+        size = rows * 8
+        if offset + size * len(columns) > len(data):
+            print(f"Warning: truncated last chunk ({rows} rows dropped)",
+                  file=sys.stderr)
+            break
+        for name, kind in columns:
+            raw = data[offset:offset + size]
+            if np is not None:
+                parts[name].append(np.frombuffer(raw, dtype=DTYPES[kind]))
+            else:
+                values = array.array(TYPECODES[kind])
+                values.frombytes(raw)
+                if sys.byteorder != "little":
+                    values.byteswap()
+                parts[name].append(values)
+            offset += size
+
+    result = {}
+    for name, kind in columns:
+        if np is not None:
+            result[name] = (np.concatenate(parts[name]) if parts[name]
+                            else np.empty(0, DTYPES[kind]))
+        else:
+            merged = array.array(TYPECODES[kind])
+            for part in parts[name]:
+                merged.extend(part)
+            result[name] = merged
+    return result
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.strip().split("\n")[0])
+    parser.add_argument("file", help="Recording written by --record")
+    parser.add_argument("--columns",
+                        help="Comma-separated columns (default: all)")
+    parser.add_argument("--csv", metavar="OUT",
+                        help="Export the selected columns to CSV")
+    args = parser.parse_args()
+
+    table = load_jcol(args.file)
+    names = args.columns.split(",") if args.columns else list(table)
+    missing = [name for name in names if name not in table]
+    if missing:
+        sys.exit(f"Unknown columns: {', '.join(missing)}")
+
+    rows = len(table[names[0]]) if names else 0
+    if args.csv:
+        with open(args.csv, "w") as out:
+            out.write(",".join(names) + "\n")
+            for i in range(rows):
+                out.write(",".join(repr(table[n][i]) if isinstance(
+                    table[n][i], float) else str(table[n][i])
+                    for n in names) + "\n")
+        print(f"Wrote {rows} rows to {args.csv}")
+        return
+
+    print(f"{args.file}: {rows} rows, {len(table)} columns")
+    for name in names:
+        values = table[name]
+        if rows:
+            print(f"  {name:45s} min={min(values):<14g} max={max(values):g}")
+        else:
+            print(f"  {name}")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,204 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 Jettison Project Team
+
+#include "anomaly_detector.h"
+#include <algorithm>
+#include <cmath>
+
+namespace jettison
+{
+
+using google::protobuf::FieldDescriptor;
+
+AnomalyDetector::AnomalyDetector (AnomalyConfig config) : config_ (config)
+{
+  for (auto &field : FieldAccessor::numeric_leaves ())
+    {
+      const auto type = field.chain ().back ()->cpp_type ();
+      if (type == FieldDescriptor::CPPTYPE_BOOL
+          || type == FieldDescriptor::CPPTYPE_ENUM)
+        {
+          continue;
+        }
+
+      double noise_floor = 0.0;
+      if (const auto range = field.declared_range ())
+        {
+          noise_floor = 0.01 * (range->max - range->min);
+        }
+      const double period = field.wrap_period ();
+      if (period > 0.0)
+        {
+          angles_.push_back (fields_.size ());
+        }
+      FieldPath path;
+      for (const auto *descriptor : field.chain ())
+        {
+          path.push (descriptor->number ());
+        }
+      paths_.push_back (path);
+      period_.push_back (period);
+      floor_.push_back (noise_floor);
+      fields_.push_back (std::move (field));
+    }
+
+  const size_t n = fields_.size ();
+  value_.resize (n);
+  previous_.resize (n);
+  step_.resize (n);
+  mean_.resize (n);
+  var_.resize (n);
+  step_mean_.resize (n);
+  step_var_.resize (n);
+  changed_at_.resize (n);
+  changes_.resize (n);
+  stuck_.resize (n);
+  flags_.resize (n);
+}
+
+size_t
+AnomalyDetector::check (const ser::JonGUIState &state, int64_t time_ns,
+                        std::vector<Violation> &warnings)
+{
+  const size_t n = fields_.size ();
+  double *const x = value_.data ();
+  for (size_t f = 0; f < n; ++f)
+    {
+      x[f] = fields_[f].get (state);
+    }
+
+  if (frames_ == 0)
+    {
+      std::copy (value_.begin (), value_.end (), previous_.begin ());
+      std::copy (value_.begin (), value_.end (), mean_.begin ());
+      std::fill (changed_at_.begin (), changed_at_.end (), time_ns);
+      frames_ = 1;
+      return 0;
+    }
+
+  double *const prev = previous_.data ();
+  double *const step = step_.data ();
+  double *const mean = mean_.data ();
+  double *const var = var_.data ();
+  double *const step_mean = step_mean_.data ();
+  double *const step_var = step_var_.data ();
+  const double *const period = period_.data ();
+  const double *const noise = floor_.data ();
+  uint8_t *const flags = flags_.data ();
+
+  // Frame-to-frame steps, then wrap the few angle fields
+  for (size_t f = 0; f < n; ++f)
+    {
+      step[f] = x[f] - prev[f];
+    }
+  for (const size_t f : angles_)
+    {
+      step[f] = std::remainder (step[f], period[f]);
+    }
+
+  // Flag against the statistics of previous frames
+  const bool armed = frames_ >= config_.warmup_frames;
+  const double k = config_.z_threshold;
+  for (size_t f = 0; f < n; ++f)
+    {
+      const double jump_limit = k * std::sqrt (step_var[f]) + noise[f]
+                                + 0.5 * std::fabs (step_mean[f]);
+      const double spike_limit = k * std::sqrt (var[f]) + noise[f]
+                                 + 1e-3 * std::fabs (mean[f]);
+      const bool jump = std::fabs (step[f] - step_mean[f]) > jump_limit;
+      const bool spike
+          = period[f] == 0.0 && std::fabs (x[f] - mean[f]) > spike_limit;
+      flags[f] = static_cast<uint8_t> (armed ? (jump ? JUMP : 0)
+                                                   | (spike ? SPIKE : 0)
+                                             : 0);
+    }
+
+  // Stuck values: fields that used to vary but stopped changing
+  const auto stuck_ns = static_cast<int64_t> (config_.stuck_seconds * 1e9);
+  for (size_t f = 0; f < n; ++f)
+    {
+      const bool changed = x[f] != prev[f];
+      changed_at_[f] = changed ? time_ns : changed_at_[f];
+      changes_[f] += changed ? 1U : 0U;
+      stuck_[f] = changed ? 0 : stuck_[f];
+
+      const bool stuck = stuck_[f] == 0
+                         && changes_[f] >= config_.stuck_min_changes
+                         && time_ns - changed_at_[f] > stuck_ns;
+      stuck_[f] = stuck ? 1 : stuck_[f];
+      flags[f] = static_cast<uint8_t> (flags[f] | (stuck ? STUCK : 0));
+    }
+
+  // Report against the statistics the frame was judged by
+  size_t anomalies = 0;
+  for (size_t f = 0; f < n; ++f)
+    {
+      if (flags[f] != 0)
+        {
+          report (f, flags[f], time_ns, warnings);
+          anomalies++;
+        }
+    }
+
+  // Running (1/n) update of values and steps, exponentially weighted
+  // once window_frames is reached
+  const double a = 1.0 / std::min (frames_ + 1, config_.window_frames);
+  const double a_step = 1.0 / std::min (frames_, config_.window_frames);
+  for (size_t f = 0; f < n; ++f)
+    {
+      const double d = x[f] - mean[f];
+      mean[f] += a * d;
+      var[f] = (1.0 - a) * (var[f] + a * d * d);
+
+      const double ds = step[f] - step_mean[f];
+      step_mean[f] += a_step * ds;
+      step_var[f] = (1.0 - a_step) * (step_var[f] + a_step * ds * ds);
+    }
+
+  std::copy (value_.begin (), value_.end (), previous_.begin ());
+  frames_++;
+
+  return anomalies;
+}
+
+void
+AnomalyDetector::report (size_t field, uint8_t flags, int64_t time_ns,
+                         std::vector<Violation> &warnings) const
+{
+  static const uint32_t jump_rule = RuleTable::intern ("anomaly.jump");
+  static const uint32_t spike_rule = RuleTable::intern ("anomaly.spike");
+  static const uint32_t stuck_rule = RuleTable::intern ("anomaly.stuck");
+
+  Violation violation;
+  violation.field = paths_[field];
+
+  if ((flags & JUMP) != 0)
+    {
+      violation.kind = Violation::Kind::Jump;
+      violation.rule = jump_rule;
+      violation.value = step_[field];
+      violation.context = { step_mean_[field], std::sqrt (step_var_[field]) };
+      warnings.push_back (violation);
+    }
+  if ((flags & SPIKE) != 0)
+    {
+      violation.kind = Violation::Kind::Spike;
+      violation.rule = spike_rule;
+      violation.value = value_[field];
+      violation.context = { mean_[field], std::sqrt (var_[field]) };
+      warnings.push_back (violation);
+    }
+  if ((flags & STUCK) != 0)
+    {
+      violation.kind = Violation::Kind::Stuck;
+      violation.rule = stuck_rule;
+      violation.value = value_[field];
+      violation.context = {
+        static_cast<double> ((time_ns - changed_at_[field]) / 1000000000),
+        Violation::NONE
+      };
+      warnings.push_back (violation);
+    }
+}
+
+} // namespace jettison
@@ -0,0 +1,113 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 Jettison Project Team
+
+#ifndef ANOMALY_DETECTOR_H
+#define ANOMALY_DETECTOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "field_accessor.h"
+#include "jon_shared_data.pb.h"
+#include "violation.h"
+
+namespace jettison
+{
+
+/**
+ * @brief Thresholds for AnomalyDetector
+ */
+struct AnomalyConfig
+{
+  double z_threshold = 6.0;        // Flag beyond this many std deviations
+  uint32_t warmup_frames = 100;    // Frames learned before flagging
+  uint32_t window_frames = 1000;   // Statistics fade over about this many
+  double stuck_seconds = 600.0;    // Flag a varying field frozen this long
+  uint32_t stuck_min_changes = 10; // Changes before a field counts as varying
+};
+
+/**
+ * @brief Online anomaly detection on top of static buf.validate ranges
+ *
+ * Tracks every numeric (non-bool, non-enum) field of JonGUIState and
+ * flags, per frame:
+ * - jumps: a frame-to-frame step far outside the field's recent step
+ *   distribution (e.g. a compass jumping 170 degrees);
+ * - spikes: a value far outside its recent distribution;
+ * - stuck values: a field that used to vary, unchanged for too long.
+ *
+ * Means and variances are updated incrementally with weight 1/n, i.e.
+ * the plain running mean and variance, until window_frames is reached;
+ * from then on the weight stays at 1/window_frames, an exponentially
+ * weighted average. Fields whose declared range is one full turn, such
+ * as [0, 360), are treated as angles (FieldAccessor::wrap_period()):
+ * steps wrap around and spikes are not checked. A noise floor
+ * of 1% of the declared span keeps near-constant fields quiet.
+ *
+ * State is laid out as one array per statistic, indexed by field, and
+ * each frame updates all of them with straight loops the compiler
+ * vectorizes. One detector follows one stream; it is not thread-safe.
+ */
+class AnomalyDetector
+{
+public:
+  /**
+   * @brief Construct a detector for all numeric fields
+   * @param config Thresholds
+   */
+  explicit AnomalyDetector (AnomalyConfig config);
+  AnomalyDetector () : AnomalyDetector (AnomalyConfig{}) {}
+
+  /**
+   * @brief Check a frame and learn from it
+   * @param state Parsed, validated state
+   * @param time_ns Frame time in ns (used for stuck detection)
+   * @param warnings Receives one Violation per anomaly
+   * @return Number of anomalies flagged
+   */
+  size_t check (const ser::JonGUIState &state, int64_t time_ns,
+                std::vector<Violation> &warnings);
+
+  /**
+   * @brief Get the number of tracked fields
+   * @return Field count
+   */
+  size_t field_count () const { return fields_.size (); }
+
+private:
+  enum Flag : uint8_t
+  {
+    JUMP = 1,
+    SPIKE = 2,
+    STUCK = 4
+  };
+
+  void report (size_t field, uint8_t flags, int64_t time_ns,
+               std::vector<Violation> &warnings) const;
+
+  AnomalyConfig config_;
+  std::vector<FieldAccessor> fields_;
+  std::vector<FieldPath> paths_;
+  uint32_t frames_ = 0;
+
+  // Per-field state, one array per statistic
+  std::vector<double> value_;       // Current frame
+  std::vector<double> previous_;    // Previous frame
+  std::vector<double> step_;        // value - previous (wrapped)
+  std::vector<double> mean_;        // Value mean
+  std::vector<double> var_;         // Value variance
+  std::vector<double> step_mean_;   // Step mean
+  std::vector<double> step_var_;    // Step variance
+  std::vector<double> period_;      // Wrap period (0 = not an angle)
+  std::vector<size_t> angles_;      // Indices of fields with a period
+  std::vector<double> floor_;       // Noise floor from the declared range
+  std::vector<int64_t> changed_at_; // Time of the last change
+  std::vector<uint32_t> changes_;   // Number of changes seen
+  std::vector<uint8_t> stuck_;      // Stuck already reported
+  std::vector<uint8_t> flags_;      // This frame's flags
+};
+
+} // namespace jettison
+
+#endif // ANOMALY_DETECTOR_H
@@ -0,0 +1,538 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 Jettison Project Team
+
+#include "cli_options.h"
+#include "field_watcher.h"
+#include "output_throttle.h"
+#include "realtime.h"
+#include "sink_graph.h"
+#include "state_comparator.h"
+#include "violation_aggregator.h"
+#include "websocket_client.h"
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace jettison
+{
+
+namespace
+{
+
+/**
+ * @brief Fields and tolerances checked by "--compare default"
+ */
+const std::vector<CompareSpec> DEFAULT_COMPARE_FIELDS = {
+  { "gps.latitude", 1e-5, 0.0 },
+  { "gps.longitude", 1e-5, 0.0 },
+  { "gps.altitude", 5.0, 0.0 },
+  { "time.timestamp", 1.0, 0.0 },
+  { "meteo_internal.temperature", 1.0, 0.0 },
+  { "meteo_internal.humidity", 2.0, 0.0 },
+  { "meteo_internal.pressure", 2.0, 0.0 },
+};
+
+/**
+ * @brief Fields kept by "--history default"
+ */
+const std::vector<std::string> DEFAULT_HISTORY_FIELDS = {
+  "rotary.azimuth",           "rotary.elevation",
+  "compass.azimuth",          "compass.elevation",
+  "compass.bank",             "gps.latitude",
+  "gps.longitude",            "gps.altitude",
+  "meteo_internal.temperature", "meteo_internal.humidity",
+  "meteo_internal.pressure",  "system.cpu_temperature",
+};
+
+/**
+ * @brief What the options have set so far
+ */
+struct ParseState
+{
+  CliOptions &cli;
+  std::vector<std::string> host_specs; // Resolved once all are parsed
+
+  StreamOptions &stream () { return cli.stream; }
+  ReceiverOptions &receiver () { return cli.stream.receiver; }
+};
+
+/**
+ * @brief One command-line option
+ *
+ * apply() reports its own errors; flags get an empty value.
+ */
+struct OptionSpec
+{
+  std::string_view name;
+  bool takes_value;
+  bool (*apply) (ParseState &state, const std::string &value);
+};
+
+bool
+invalid (std::string_view option, const std::string &value)
+{
+  std::cerr << "Error: invalid " << option << " '" << value << "'\n";
+  return false;
+}
+
+/**
+ * @brief Parse a whole string as a number
+ *
+ * Writes "invalid value for OPTION" if anything but the number is in it.
+ */
+template <typename T>
+bool
+read_number (std::string_view option, const std::string &value, T &number)
+{
+  const char *const end = value.data () + value.size ();
+  const auto [ptr, ec] = std::from_chars (value.data (), end, number);
+  if (ec != std::errc () || ptr != end || value.empty ())
+    {
+      std::cerr << "Error: invalid value for " << option << "\n";
+      return false;
+    }
+  return true;
+}
+
+/**
+ * @brief Append the non-empty items of a comma-separated list
+ */
+void
+split_list (const std::string &value, std::vector<std::string> &items)
+{
+  std::istringstream list (value);
+  std::string item;
+  while (std::getline (list, item, ','))
+    {
+      if (!item.empty ())
+        {
+          items.push_back (item);
+        }
+    }
+}
+
+/**
+ * @brief Append hosts from a file (one per line, '#' starts a comment)
+ */
+bool
+read_hosts_file (const std::string &filename, std::vector<std::string> &specs)
+{
+  std::ifstream file (filename);
+  if (!file.is_open ())
+    {
+      std::cerr << "Error: cannot open hosts file: " << filename << "\n";
+      return false;
+    }
+
+  std::string line;
+  while (std::getline (file, line))
+    {
+      const size_t hash = line.find ('#');
+      if (hash != std::string::npos)
+        {
+          line.erase (hash);
+        }
+      const size_t first = line.find_first_not_of (" \t\r");
+      if (first == std::string::npos)
+        {
+          continue;
+        }
+      const size_t last = line.find_last_not_of (" \t\r");
+      specs.push_back (line.substr (first, last - first + 1));
+    }
+
+  return true;
+}
+
+/**
+ * @brief Parse "SINK=N[:POLICY]", e.g. "record=100000:block"
+ */
+bool
+apply_sink_queue (ParseState &state, const std::string &value)
+{
+  const size_t equals = value.find ('=');
+  const std::string sink = value.substr (0, equals);
+  const size_t colon = value.find (':', equals);
+  SinkQueueSpec spec;
+  bool ok = equals != std::string::npos
+            && (sink == "dump" || sink == "capture" || sink == "ndjson"
+                || sink == "shm" || sink == "record");
+  if (ok && colon != std::string::npos)
+    {
+      spec.overflow = parse_overflow_policy (value.substr (colon + 1));
+      ok = spec.overflow.has_value ();
+    }
+  if (ok)
+    {
+      const std::string capacity
+          = value.substr (equals + 1, colon - equals - 1);
+      ok = !capacity.empty ()
+           && capacity.find_first_not_of ("0123456789") == std::string::npos
+           && capacity.size () < 10;
+      if (ok)
+        {
+          spec.capacity = std::stoul (capacity);
+          ok = spec.capacity > 0;
+        }
+    }
+  if (!ok)
+    {
+      return invalid ("--sink-queue", value);
+    }
+  state.stream ().sink_queues[sink] = spec;
+  return true;
+}
+
+// In the order of the help text
+const OptionSpec OPTIONS[] = {
+  { "--dump", true,
+    [] (ParseState &state, const std::string &value) {
+      int &count = state.stream ().dump_count;
+      if (!read_number ("--dump", value, count))
+        {
+          return false;
+        }
+      if (count <= 0)
+        {
+          std::cerr << "Error: dump count must be positive\n";
+          return false;
+        }
+      return true;
+    } },
+  { "--rate", true,
+    [] (ParseState &state, const std::string &value) {
+      double &hz = state.stream ().max_hz;
+      if (!read_number ("--rate", value, hz))
+        {
+          return false;
+        }
+      if (!std::isfinite (hz) || hz < OutputThrottle::MIN_HZ)
+        {
+          std::cerr << "Error: rate must be at least "
+                    << OutputThrottle::MIN_HZ << " Hz\n";
+          return false;
+        }
+      return true;
+    } },
+  { "--every", true,
+    [] (ParseState &state, const std::string &value) {
+      int every = 0;
+      if (!read_number ("--every", value, every))
+        {
+          return false;
+        }
+      if (every <= 0)
+        {
+          std::cerr << "Error: --every must be positive\n";
+          return false;
+        }
+      state.stream ().every_k = static_cast<uint32_t> (every);
+      return true;
+    } },
+  { "--hosts", true,
+    [] (ParseState &state, const std::string &value) {
+      split_list (value, state.host_specs);
+      return true;
+    } },
+  { "--hosts-file", true,
+    [] (ParseState &state, const std::string &value) {
+      return read_hosts_file (value, state.host_specs);
+    } },
+  { "--workers", true,
+    [] (ParseState &state, const std::string &value) {
+      int workers = 0;
+      if (!read_number ("--workers", value, workers))
+        {
+          return false;
+        }
+      if (workers < 0)
+        {
+          std::cerr << "Error: --workers must not be negative\n";
+          return false;
+        }
+      state.receiver ().workers = static_cast<size_t> (workers);
+      return true;
+    } },
+  { "--no-reconnect", false,
+    [] (ParseState &state, const std::string &) {
+      state.receiver ().reconnect.enabled = false;
+      return true;
+    } },
+  { "--reconnect-max", true,
+    [] (ParseState &state, const std::string &value) {
+      int max_ms = 0;
+      if (!read_number ("--reconnect-max", value, max_ms))
+        {
+          return false;
+        }
+      if (max_ms <= 0)
+        {
+          std::cerr << "Error: --reconnect-max must be positive\n";
+          return false;
+        }
+      state.receiver ().reconnect.max_delay_ms
+          = static_cast<uint32_t> (max_ms);
+      return true;
+    } },
+  { "--deflate", false,
+    [] (ParseState &state, const std::string &) {
+      state.receiver ().deflate.enabled = true;
+      return true;
+    } },
+  { "--deflate-window-bits", true,
+    [] (ParseState &state, const std::string &value) {
+      int bits = 0;
+      if (!read_number ("--deflate-window-bits", value, bits))
+        {
+          return false;
+        }
+      if (bits < 8 || bits > 15)
+        {
+          std::cerr << "Error: --deflate-window-bits must be 8-15\n";
+          return false;
+        }
+      state.receiver ().deflate.enabled = true;
+      state.receiver ().deflate.server_max_window_bits = bits;
+      return true;
+    } },
+  { "--deflate-no-context-takeover", false,
+    [] (ParseState &state, const std::string &) {
+      DeflateOptions &deflate = state.receiver ().deflate;
+      deflate.enabled = true;
+      deflate.server_no_context_takeover = true;
+      deflate.client_no_context_takeover = true;
+      return true;
+    } },
+  { "--anomalies", false,
+    [] (ParseState &state, const std::string &) {
+      state.receiver ().detect_anomalies = true;
+      return true;
+    } },
+  { "--skip-duplicates", false,
+    [] (ParseState &state, const std::string &) {
+      state.receiver ().skip_duplicates = true;
+      return true;
+    } },
+  { "--realtime", false,
+    [] (ParseState &state, const std::string &) {
+      state.receiver ().realtime.enabled = true;
+      return true;
+    } },
+  { "--cpus", true,
+    [] (ParseState &state, const std::string &value) {
+      RealtimeOptions &realtime = state.receiver ().realtime;
+      realtime.cpus.clear ();
+      if (!parse_cpu_list (value, realtime.cpus))
+        {
+          return invalid ("--cpus", value);
+        }
+      realtime.enabled = true;
+      return true;
+    } },
+  { "--rt-priority", true,
+    [] (ParseState &state, const std::string &value) {
+      int priority = 0;
+      if (!read_number ("--rt-priority", value, priority))
+        {
+          return false;
+        }
+      if (priority < 1 || priority > 99)
+        {
+          std::cerr << "Error: --rt-priority must be 1-99\n";
+          return false;
+        }
+      state.receiver ().realtime.enabled = true;
+      state.receiver ().realtime.priority = priority;
+      return true;
+    } },
+  { "--violation-window", true,
+    [] (ParseState &state, const std::string &value) {
+      double &window = state.stream ().violation_window;
+      if (!read_number ("--violation-window", value, window))
+        {
+          return false;
+        }
+      const auto max_window
+          = std::chrono::duration<double> (ViolationAggregator::MAX_WINDOW);
+      if (!std::isfinite (window) || window < 0.0
+          || window > max_window.count ())
+        {
+          std::cerr << "Error: --violation-window must be 0-"
+                    << max_window.count () << " s\n";
+          return false;
+        }
+      return true;
+    } },
+  { "--shm", true,
+    [] (ParseState &state, const std::string &value) {
+      // POSIX shm names start with a single slash
+      state.stream ().shm_name
+          = value.rfind ('/', 0) == 0 ? value : "/" + value;
+      return true;
+    } },
+  { "--record", true,
+    [] (ParseState &state, const std::string &value) {
+      state.stream ().record_file = value;
+      return true;
+    } },
+  { "--capture", true,
+    [] (ParseState &state, const std::string &value) {
+      state.stream ().capture_file = value;
+      return true;
+    } },
+  { "--ndjson", true,
+    [] (ParseState &state, const std::string &value) {
+      state.stream ().ndjson_file = value;
+      return true;
+    } },
+  { "--sink-queue", true, apply_sink_queue },
+  { "--history", true,
+    [] (ParseState &state, const std::string &value) {
+      if (value == "default")
+        {
+          state.stream ().history_fields = DEFAULT_HISTORY_FIELDS;
+          return true;
+        }
+      split_list (value, state.stream ().history_fields);
+      return true;
+    } },
+  { "--watch", true,
+    [] (ParseState &state, const std::string &value) {
+      auto spec = parse_watch_spec (value);
+      if (!spec)
+        {
+          return invalid ("--watch", value);
+        }
+      state.stream ().watches.push_back (*spec);
+      return true;
+    } },
+  { "--compare", true,
+    [] (ParseState &state, const std::string &value) {
+      std::vector<CompareSpec> &compares = state.stream ().compares;
+      if (value == "default")
+        {
+          compares.insert (compares.end (), DEFAULT_COMPARE_FIELDS.begin (),
+                           DEFAULT_COMPARE_FIELDS.end ());
+          return true;
+        }
+      auto spec = parse_compare_spec (value);
+      if (!spec)
+        {
+          return invalid ("--compare", value);
+        }
+      compares.push_back (*spec);
+      return true;
+    } },
+  { "--align-by", true,
+    [] (ParseState &state, const std::string &value) {
+      state.stream ().align_by = value;
+      return true;
+    } },
+  { "--log-level", true,
+    [] (ParseState &state, const std::string &value) {
+      const auto level = parse_log_level (value);
+      if (!level)
+        {
+          return invalid ("--log-level", value);
+        }
+      state.cli.log_level = *level;
+      return true;
+    } },
+};
+
+const OptionSpec *
+find_option (std::string_view name)
+{
+  for (const auto &option : OPTIONS)
+    {
+      if (option.name == name)
+        {
+          return &option;
+        }
+    }
+  return nullptr;
+}
+
+} // namespace
+
+CliParseResult
+parse_stream_options (int argc, char *argv[], CliOptions &options)
+{
+  ParseState state{ options, {} };
+  state.receiver ().reconnect.enabled = true;
+
+  for (int i = 1; i < argc; ++i)
+    {
+      const std::string arg = argv[i];
+      if (arg.rfind ("--", 0) != 0)
+        {
+          state.host_specs.push_back (arg);
+          continue;
+        }
+
+      const OptionSpec *option = find_option (arg);
+      if (option == nullptr)
+        {
+          std::cerr << "Error: unknown argument '" << arg << "'\n\n";
+          return CliParseResult::Usage;
+        }
+      std::string value;
+      if (option->takes_value)
+        {
+          if (i + 1 >= argc)
+            {
+              std::cerr << "Error: " << arg << " requires a value\n\n";
+              return CliParseResult::Usage;
+            }
+          value = argv[++i];
+        }
+      if (!option->apply (state, value))
+        {
+          return CliParseResult::Invalid;
+        }
+    }
+
+  if (state.host_specs.empty ())
+    {
+      std::cerr << "Error: no host given\n\n";
+      return CliParseResult::Usage;
+    }
+
+  ReceiverOptions &receiver = state.receiver ();
+  for (const auto &spec : state.host_specs)
+    {
+      auto endpoint = parse_endpoint (spec);
+      if (!endpoint)
+        {
+          std::cerr << "Error: invalid host '" << spec << "'\n";
+          return CliParseResult::Invalid;
+        }
+      receiver.endpoints.push_back (*endpoint);
+    }
+
+  if (receiver.deflate.enabled && !WebSocketClient::deflate_supported ())
+    {
+      std::cerr << "Error: --deflate needs libwebsockets built with "
+                   "extensions (LWS_WITHOUT_EXTENSIONS=OFF)\n";
+      return CliParseResult::Invalid;
+    }
+  if (options.stream.dump_count > 0 && receiver.endpoints.size () > 1)
+    {
+      std::cerr << "Error: --dump supports a single host only\n";
+      return CliParseResult::Invalid;
+    }
+  if (!options.stream.compares.empty () && receiver.endpoints.size () < 2)
+    {
+      std::cerr << "Error: --compare needs at least two hosts\n";
+      return CliParseResult::Invalid;
+    }
+  return CliParseResult::Ok;
+}
+
+} // namespace jettison
@@ -0,0 +1,51 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 Jettison Project Team
+
+#ifndef CLI_OPTIONS_H
+#define CLI_OPTIONS_H
+
+#include "logger.h"
+#include "stream_session.h"
+
+namespace jettison
+{
+
+/**
+ * @brief Everything the stream mode's command line sets
+ */
+struct CliOptions
+{
+  StreamOptions stream;
+  LogLevel log_level = LogLevel::Info;
+};
+
+/**
+ * @brief Outcome of parse_stream_options()
+ */
+enum class CliParseResult
+{
+  Ok,
+  Usage,  // Unknown option, missing value or no host (show the help)
+  Invalid // A value was rejected
+};
+
+/**
+ * @brief Parse the stream mode's command line
+ *
+ * Options are looked up in one table, which holds each option's name,
+ * whether it takes a value, and how it applies the value. Arguments not
+ * starting with "--" are hosts. Endpoints are resolved, and
+ * combinations the session cannot run (e.g. --compare with one host)
+ * are rejected. Errors are written to stderr.
+ *
+ * @param argc Argument count, as given to main()
+ * @param argv Arguments, as given to main()
+ * @param options Filled in; reconnecting is on unless --no-reconnect
+ * @return Whether parsing succeeded, and if not, whether to show usage
+ */
+CliParseResult parse_stream_options (int argc, char *argv[],
+                                     CliOptions &options);
+
+} // namespace jettison
+
+#endif // CLI_OPTIONS_H
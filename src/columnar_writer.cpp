@@ -0,0 +1,243 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 Jettison Project Team
+
+#include "columnar_writer.h"
+#include "logger.h"
+#include <cstring>
+#include <sstream>
+
+namespace jettison
+{
+
+using google::protobuf::FieldDescriptor;
+
+namespace
+{
+
+constexpr char FILE_MAGIC[8] = { 'J', 'C', 'O', 'L', '0', '0', '0', '1' };
+constexpr char CHUNK_MAGIC[4] = { 'C', 'H', 'N', 'K' };
+constexpr size_t FIXED_COLUMNS = 3; // frame, rx_unix_ns, valid
+
+template <typename T>
+void
+put_le (std::ostream &out, T value)
+{
+  uint8_t bytes[sizeof (T)];
+  for (size_t i = 0; i < sizeof (T); ++i)
+    {
+      bytes[i] = static_cast<uint8_t> (static_cast<uint64_t> (value) >> (8 * i));
+    }
+  out.write (reinterpret_cast<const char *> (bytes), sizeof (T));
+}
+
+uint64_t
+double_bits (double value)
+{
+  uint64_t bits;
+  std::memcpy (&bits, &value, sizeof bits);
+  return bits;
+}
+
+} // namespace
+
+ColumnarWriter::ColumnarWriter (size_t chunk_rows)
+    : fields_ (FieldAccessor::numeric_leaves ()),
+      chunk_rows_ (chunk_rows > 0 ? chunk_rows : DEFAULT_CHUNK_ROWS)
+{
+  names_ = { "frame", "rx_unix_ns", "valid" };
+  types_ = { ColumnType::I64, ColumnType::I64, ColumnType::I64 };
+  for (const auto &field : fields_)
+    {
+      names_.push_back (field.path ());
+      switch (field.chain ().back ()->cpp_type ())
+        {
+        case FieldDescriptor::CPPTYPE_DOUBLE:
+        case FieldDescriptor::CPPTYPE_FLOAT:
+          types_.push_back (ColumnType::F64);
+          break;
+        case FieldDescriptor::CPPTYPE_UINT64:
+          types_.push_back (ColumnType::U64);
+          break;
+        default:
+          types_.push_back (ColumnType::I64);
+          break;
+        }
+    }
+  columns_.resize (names_.size ());
+}
+
+ColumnarWriter::~ColumnarWriter () { close (); }
+
+ColumnarWriter::Format
+ColumnarWriter::format_for (const std::string &filename)
+{
+  const std::string csv = ".csv";
+  if (filename.size () >= csv.size ()
+      && filename.compare (filename.size () - csv.size (), csv.size (), csv)
+             == 0)
+    {
+      return Format::Csv;
+    }
+  return Format::Columnar;
+}
+
+bool
+ColumnarWriter::open (const std::string &filename, Format format)
+{
+  format_ = format;
+  file_.open (filename, std::ios::binary | std::ios::trunc);
+  if (!file_.is_open ())
+    {
+      log_error ("Failed to create recording file: ", filename);
+      return false;
+    }
+
+  for (auto &column : columns_)
+    {
+      column.reserve (format_ == Format::Columnar ? chunk_rows_ : 1);
+    }
+
+  if (format_ == Format::Csv)
+    {
+      for (size_t i = 0; i < names_.size (); ++i)
+        {
+          file_ << (i > 0 ? "," : "") << names_[i];
+        }
+      file_ << "\n";
+      return file_.good ();
+    }
+
+  file_.write (FILE_MAGIC, sizeof FILE_MAGIC);
+  put_le<uint32_t> (file_, static_cast<uint32_t> (names_.size ()));
+  for (size_t i = 0; i < names_.size (); ++i)
+    {
+      put_le<uint16_t> (file_, static_cast<uint16_t> (names_[i].size ()));
+      file_.write (names_[i].data (),
+                   static_cast<std::streamsize> (names_[i].size ()));
+      put_le<uint8_t> (file_, static_cast<uint8_t> (types_[i]));
+    }
+  return file_.good ();
+}
+
+void
+ColumnarWriter::append (const ser::JonGUIState &state, uint64_t frame,
+                        int64_t rx_unix_ns, bool valid)
+{
+  if (!file_.is_open ())
+    {
+      return;
+    }
+
+  columns_[0].push_back (frame);
+  columns_[1].push_back (static_cast<uint64_t> (rx_unix_ns));
+  columns_[2].push_back (valid ? 1 : 0);
+  for (size_t i = 0; i < fields_.size (); ++i)
+    {
+      // Integers are read natively; a double only holds 53 bits
+      uint64_t cell;
+      switch (types_[FIXED_COLUMNS + i])
+        {
+        case ColumnType::F64:
+          cell = double_bits (fields_[i].get (state));
+          break;
+        case ColumnType::U64:
+          cell = fields_[i].get_uint64 (state);
+          break;
+        case ColumnType::I64:
+        default:
+          cell = static_cast<uint64_t> (fields_[i].get_int64 (state));
+          break;
+        }
+      columns_[FIXED_COLUMNS + i].push_back (cell);
+    }
+  buffered_++;
+  rows_++;
+
+  if (format_ == Format::Csv || buffered_ >= chunk_rows_)
+    {
+      flush_chunk ();
+    }
+}
+
+void
+ColumnarWriter::flush_chunk ()
+{
+  if (buffered_ == 0)
+    {
+      return;
+    }
+
+  if (format_ == Format::Csv)
+    {
+      std::ostringstream line;
+      line.precision (17);
+      for (size_t row = 0; row < buffered_; ++row)
+        {
+          for (size_t i = 0; i < columns_.size (); ++i)
+            {
+              line << (i > 0 ? "," : "");
+              const uint64_t cell = columns_[i][row];
+              switch (types_[i])
+                {
+                case ColumnType::I64:
+                  line << static_cast<int64_t> (cell);
+                  break;
+                case ColumnType::U64:
+                  line << cell;
+                  break;
+                case ColumnType::F64:
+                default:
+                  {
+                    double value;
+                    std::memcpy (&value, &cell, sizeof value);
+                    line << value;
+                    break;
+                  }
+                }
+            }
+          line << "\n";
+        }
+      file_ << line.str ();
+    }
+  else
+    {
+      file_.write (CHUNK_MAGIC, sizeof CHUNK_MAGIC);
+      put_le<uint32_t> (file_, static_cast<uint32_t> (buffered_));
+      std::vector<uint8_t> bytes (buffered_ * 8);
+      for (const auto &column : columns_)
+        {
+          for (size_t row = 0; row < buffered_; ++row)
+            {
+              for (size_t b = 0; b < 8; ++b)
+                {
+                  bytes[row * 8 + b]
+                      = static_cast<uint8_t> (column[row] >> (8 * b));
+                }
+            }
+          file_.write (reinterpret_cast<const char *> (bytes.data ()),
+                       static_cast<std::streamsize> (bytes.size ()));
+        }
+    }
+
+  for (auto &column : columns_)
+    {
+      column.clear ();
+    }
+  buffered_ = 0;
+}
+
+bool
+ColumnarWriter::close ()
+{
+  if (!file_.is_open ())
+    {
+      return true;
+    }
+  flush_chunk ();
+  file_.flush ();
+  const bool ok = file_.good ();
+  file_.close ();
+  return ok;
+}
+
+} // namespace jettison
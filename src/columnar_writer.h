@@ -0,0 +1,134 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 Jettison Project Team
+
+#ifndef COLUMNAR_WRITER_H
+#define COLUMNAR_WRITER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "field_accessor.h"
+#include "jon_shared_data.pb.h"
+
+namespace jettison
+{
+
+/**
+ * @brief Records flattened numeric state fields as a column table
+ *
+ * Every numeric, bool and enum field of JonGUIState becomes a column,
+ * after three leading columns: `frame` (sequence number), `rx_unix_ns`
+ * (receive time, 0 if unknown) and `valid` (1 if validation passed).
+ * Rows are buffered per column and written in chunks.
+ *
+ * Columnar file layout (all integers little-endian):
+ * @code
+ *   "JCOL0001"  u32 column_count
+ *   column_count x { u16 name_len, name, u8 type (0 = f64, 1 = i64,
+ *                                                 2 = u64) }
+ *   chunk*:  "CHNK"  u32 row_count  column_count x (row_count x 8 bytes)
+ * @endcode
+ * Chunks are self-contained, so a truncated file loses at most the last
+ * chunk. scripts/read_columns.py loads it into numpy arrays.
+ */
+class ColumnarWriter
+{
+public:
+  enum class Format
+  {
+    Columnar, // Binary column chunks (.jcol)
+    Csv       // One text row per frame
+  };
+
+  static constexpr size_t DEFAULT_CHUNK_ROWS = 65536;
+
+  /**
+   * @brief Construct a writer
+   * @param chunk_rows Rows buffered before a chunk is written
+   */
+  explicit ColumnarWriter (size_t chunk_rows = DEFAULT_CHUNK_ROWS);
+
+  /**
+   * @brief Flush and close
+   */
+  ~ColumnarWriter ();
+
+  // Non-copyable, non-movable
+  ColumnarWriter (const ColumnarWriter &) = delete;
+  ColumnarWriter &operator= (const ColumnarWriter &) = delete;
+  ColumnarWriter (ColumnarWriter &&) = delete;
+  ColumnarWriter &operator= (ColumnarWriter &&) = delete;
+
+  /**
+   * @brief Pick a format from a file name (.csv = CSV, else columnar)
+   * @param filename Output file name
+   * @return Format to use
+   */
+  static Format format_for (const std::string &filename);
+
+  /**
+   * @brief Create the output file and write the header
+   * @param filename Output file path
+   * @param format Output format
+   * @return true if the file was opened
+   */
+  bool open (const std::string &filename, Format format);
+
+  /**
+   * @brief Append one frame as a row
+   * @param state Parsed state
+   * @param frame Frame sequence number
+   * @param rx_unix_ns Receive time in ns since the Unix epoch (0 = unknown)
+   * @param valid true if the frame passed validation
+   */
+  void append (const ser::JonGUIState &state, uint64_t frame,
+               int64_t rx_unix_ns, bool valid);
+
+  /**
+   * @brief Write buffered rows and close the file
+   * @return true if every write succeeded
+   */
+  bool close ();
+
+  /**
+   * @brief Get the number of rows appended so far
+   * @return Row count
+   */
+  uint64_t rows () const { return rows_; }
+
+  /**
+   * @brief Get the number of columns per row
+   * @return Column count
+   */
+  size_t column_count () const { return names_.size (); }
+
+private:
+  /**
+   * @brief Cell type, as written in the header
+   */
+  enum class ColumnType : uint8_t
+  {
+    F64 = 0,
+    I64 = 1,
+    U64 = 2 // uint64 fields, which may exceed INT64_MAX
+  };
+
+  void flush_chunk ();
+
+  std::vector<FieldAccessor> fields_;
+  std::vector<std::string> names_;
+  std::vector<ColumnType> types_;
+  std::vector<std::vector<uint64_t>> columns_; // Raw 8-byte cells
+  size_t chunk_rows_;
+  size_t buffered_ = 0;
+  uint64_t rows_ = 0;
+  Format format_ = Format::Columnar;
+  std::ofstream file_;
+};
+
+} // namespace jettison
+
+#endif // COLUMNAR_WRITER_H
@@ -0,0 +1,425 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 Jettison Project Team
+
+#include "dedup_store.h"
+#include "logger.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <functional>
+#include <sstream>
+#include <string_view>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace jettison
+{
+
+namespace
+{
+
+constexpr char STORE_MAGIC[8] = { 'J', 'D', 'D', 'S', '0', '0', '0', '1' };
+
+/**
+ * @brief Read a base-128 varint
+ * @return false on truncated or overlong input
+ */
+bool
+read_varint (const uint8_t *&p, const uint8_t *end, uint64_t &value)
+{
+  value = 0;
+  for (unsigned shift = 0; shift < 64 && p < end; shift += 7)
+    {
+      const uint8_t byte = *p++;
+      value |= static_cast<uint64_t> (byte & 0x7F) << shift;
+      if ((byte & 0x80) == 0)
+        {
+          return true;
+        }
+    }
+  return false;
+}
+
+void
+put_varint (std::vector<uint8_t> &out, uint64_t value)
+{
+  while (value >= 0x80)
+    {
+      out.push_back (static_cast<uint8_t> (value | 0x80));
+      value >>= 7;
+    }
+  out.push_back (static_cast<uint8_t> (value));
+}
+
+/**
+ * @brief Length of the top-level field starting at p (tag included)
+ * @return 0 if the field is not well-formed
+ */
+size_t
+field_length (const uint8_t *p, const uint8_t *end, uint32_t &number)
+{
+  const uint8_t *const start = p;
+  uint64_t tag = 0;
+  uint64_t value = 0;
+  if (!read_varint (p, end, tag))
+    {
+      return 0;
+    }
+  number = static_cast<uint32_t> (tag >> 3);
+
+  const auto remaining = static_cast<uint64_t> (end - p);
+  switch (tag & 7)
+    {
+    case 0:
+      if (!read_varint (p, end, value))
+        {
+          return 0;
+        }
+      break;
+    case 1:
+      if (remaining < 8)
+        {
+          return 0;
+        }
+      p += 8;
+      break;
+    case 2:
+      if (!read_varint (p, end, value)
+          || value > static_cast<uint64_t> (end - p))
+        {
+          return 0;
+        }
+      p += value;
+      break;
+    case 5:
+      if (remaining < 4)
+        {
+          return 0;
+        }
+      p += 4;
+      break;
+    default:
+      return 0;
+    }
+  return static_cast<size_t> (p - start);
+}
+
+uint64_t
+slice_hash (const uint8_t *data, size_t len)
+{
+  return std::hash<std::string_view>{}(
+      std::string_view (reinterpret_cast<const char *> (data), len));
+}
+
+} // namespace
+
+DedupWriter::~DedupWriter () { close (); }
+
+bool
+DedupWriter::open (const std::string &filename)
+{
+  file_.open (filename, std::ios::binary | std::ios::trunc);
+  if (!file_.is_open ())
+    {
+      log_error ("Failed to create dump store: ", filename);
+      return false;
+    }
+  file_.write (STORE_MAGIC, sizeof STORE_MAGIC);
+  position_ = sizeof STORE_MAGIC;
+  return file_.good ();
+}
+
+void
+DedupWriter::flush_pending ()
+{
+  if (pending_len_ > 0)
+    {
+      put_varint (body_, (frame_start_ - pending_offset_) << 1);
+      put_varint (body_, pending_len_);
+      pending_len_ = 0;
+    }
+
+  if (!literal_.empty ())
+    {
+      put_varint (body_, literal_.size () << 1 | 1);
+      // Literal bytes follow the frame's u32 length and the entry header
+      const uint64_t base = frame_start_ + sizeof (uint32_t) + body_.size ();
+      for (const auto &[slice, position] : unplaced_)
+        {
+          slice->offset = base + position;
+        }
+      unplaced_.clear ();
+      body_.insert (body_.end (), literal_.begin (), literal_.end ());
+      literal_.clear ();
+    }
+}
+
+void
+DedupWriter::add_slice (uint32_t field, const uint8_t *data, size_t len)
+{
+  if (len < MIN_SLICE)
+    {
+      if (pending_len_ > 0)
+        {
+          flush_pending ();
+        }
+      literal_.insert (literal_.end (), data, data + len);
+      return;
+    }
+
+  const uint64_t hash = slice_hash (data, len);
+  Recent &recent = recent_[field];
+  for (const auto &slice : recent.slices)
+    {
+      if (slice.hash != hash || slice.offset == UNPLACED
+          || slice.bytes.size () != len
+          || std::memcmp (slice.bytes.data (), data, len) != 0)
+        {
+          continue;
+        }
+      // Slices stored next to each other share one reference
+      if (pending_len_ > 0 && pending_offset_ + pending_len_ == slice.offset)
+        {
+          pending_len_ += len;
+          return;
+        }
+      flush_pending ();
+      pending_offset_ = slice.offset;
+      pending_len_ = len;
+      return;
+    }
+
+  if (pending_len_ > 0)
+    {
+      flush_pending ();
+    }
+  Slice &slot = recent.slices[recent.next];
+  recent.next = (recent.next + 1) % RECENT_SLICES;
+  slot.hash = hash;
+  slot.offset = UNPLACED;
+  slot.bytes.assign (data, data + len);
+  unplaced_.emplace_back (&slot, literal_.size ());
+  literal_.insert (literal_.end (), data, data + len);
+}
+
+bool
+DedupWriter::append (const uint8_t *data, size_t len)
+{
+  if (!file_.is_open ())
+    {
+      return false;
+    }
+
+  frame_start_ = position_;
+  body_.clear ();
+  const uint8_t *p = data;
+  const uint8_t *const end = data + len;
+  while (p < end)
+    {
+      uint32_t field = 0;
+      const size_t length = field_length (p, end, field);
+      if (length == 0)
+        {
+          // Not splittable from here on: keep the rest as one slice
+          add_slice (0, p, static_cast<size_t> (end - p));
+          break;
+        }
+      add_slice (field, p, length);
+      p += length;
+    }
+  flush_pending ();
+
+  const auto body_len = static_cast<uint32_t> (body_.size ());
+  uint8_t header[4];
+  for (size_t i = 0; i < sizeof header; ++i)
+    {
+      header[i] = static_cast<uint8_t> (body_len >> (8 * i));
+    }
+  file_.write (reinterpret_cast<const char *> (header), sizeof header);
+  file_.write (reinterpret_cast<const char *> (body_.data ()),
+               static_cast<std::streamsize> (body_.size ()));
+
+  position_ += sizeof header + body_.size ();
+  frames_++;
+  raw_bytes_ += len;
+  return file_.good ();
+}
+
+bool
+DedupWriter::close ()
+{
+  if (!file_.is_open ())
+    {
+      return true;
+    }
+  file_.flush ();
+  const bool ok = file_.good ();
+  file_.close ();
+  recent_.clear ();
+  return ok;
+}
+
+std::string
+describe_store_size (const DedupWriter &writer)
+{
+  std::ostringstream out;
+  out.setf (std::ios::fixed);
+  out.precision (1);
+  out << static_cast<double> (writer.raw_bytes ()) / 1e6 << " MB raw -> "
+      << static_cast<double> (writer.stored_bytes ()) / 1e6 << " MB stored ("
+      << static_cast<double> (writer.raw_bytes ())
+             / static_cast<double> (std::max<uint64_t> (writer.stored_bytes (),
+                                                        1))
+      << "x)";
+  return out.str ();
+}
+
+DedupReader::~DedupReader () { unmap (); }
+
+void
+DedupReader::unmap ()
+{
+  if (data_ != nullptr)
+    {
+      munmap (const_cast<uint8_t *> (data_), size_);
+      data_ = nullptr;
+    }
+  size_ = 0;
+  frames_.clear ();
+}
+
+bool
+DedupReader::is_store (const std::string &filename)
+{
+  std::ifstream file (filename, std::ios::binary);
+  char magic[sizeof STORE_MAGIC] = {};
+  file.read (magic, sizeof magic);
+  return file.good ()
+         && std::memcmp (magic, STORE_MAGIC, sizeof STORE_MAGIC) == 0;
+}
+
+bool
+DedupReader::is_store (const uint8_t *data, size_t len)
+{
+  return len >= sizeof STORE_MAGIC
+         && std::memcmp (data, STORE_MAGIC, sizeof STORE_MAGIC) == 0;
+}
+
+bool
+DedupReader::open (const std::string &filename)
+{
+  unmap ();
+
+  const int fd = ::open (filename.c_str (), O_RDONLY);
+  if (fd < 0)
+    {
+      log_error ("Failed to open dump store ", filename, ": ",
+                 std::strerror (errno));
+      return false;
+    }
+
+  struct stat st{};
+  if (fstat (fd, &st) != 0
+      || static_cast<size_t> (st.st_size) < sizeof STORE_MAGIC)
+    {
+      log_error (filename, " is not a dump store");
+      ::close (fd);
+      return false;
+    }
+
+  const auto size = static_cast<size_t> (st.st_size);
+  void *addr = mmap (nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close (fd);
+  if (addr == MAP_FAILED)
+    {
+      log_error ("Failed to map dump store ", filename, ": ",
+                 std::strerror (errno));
+      return false;
+    }
+
+  data_ = static_cast<const uint8_t *> (addr);
+  size_ = size;
+  if (!is_store (data_, size_))
+    {
+      log_error (filename, " is not a dump store");
+      unmap ();
+      return false;
+    }
+
+  // Index complete frames
+  size_t offset = sizeof STORE_MAGIC;
+  while (size_ - offset >= sizeof (uint32_t))
+    {
+      uint32_t body_len = 0;
+      for (size_t i = 0; i < sizeof body_len; ++i)
+        {
+          body_len |= static_cast<uint32_t> (data_[offset + i]) << (8 * i);
+        }
+      if (body_len > size_ - offset - sizeof body_len)
+        {
+          break;
+        }
+      frames_.push_back (offset);
+      offset += sizeof body_len + body_len;
+    }
+  if (offset != size_)
+    {
+      log_warning ("Warning: ", filename, " ends with an incomplete frame (",
+                   size_ - offset, " bytes ignored)");
+    }
+  return true;
+}
+
+bool
+DedupReader::read (size_t index, std::vector<uint8_t> &payload) const
+{
+  payload.clear ();
+  if (index >= frames_.size ())
+    {
+      return false;
+    }
+
+  const uint64_t frame_start = frames_[index];
+  uint32_t body_len = 0;
+  for (size_t i = 0; i < sizeof body_len; ++i)
+    {
+      body_len |= static_cast<uint32_t> (data_[frame_start + i]) << (8 * i);
+    }
+  const uint8_t *p = data_ + frame_start + sizeof body_len;
+  const uint8_t *const end = p + body_len;
+
+  while (p < end)
+    {
+      uint64_t header = 0;
+      if (!read_varint (p, end, header))
+        {
+          return false;
+        }
+      if ((header & 1) != 0)
+        {
+          const uint64_t len = header >> 1;
+          if (len > static_cast<uint64_t> (end - p))
+            {
+              return false;
+            }
+          payload.insert (payload.end (), p, p + len);
+          p += len;
+          continue;
+        }
+
+      const uint64_t distance = header >> 1;
+      uint64_t len = 0;
+      if (!read_varint (p, end, len) || distance > frame_start
+          || len > size_ - (frame_start - distance))
+        {
+          return false;
+        }
+      const uint8_t *slice = data_ + (frame_start - distance);
+      payload.insert (payload.end (), slice, slice + len);
+    }
+  return true;
+}
+
+} // namespace jettison
@@ -0,0 +1,218 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 Jettison Project Team
+
+#ifndef DEDUP_STORE_H
+#define DEDUP_STORE_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace jettison
+{
+
+/**
+ * @brief Records raw payloads, storing repeated top-level fields once
+ *
+ * Each JonGUIState payload is split into its top-level field slices (tag
+ * plus value, in wire order). A slice that matches one of the last
+ * RECENT_SLICES distinct slices of the same field number, compared by
+ * hash and then by bytes, is written as a back-reference to the copy
+ * already in the file; anything else is written inline. Consecutive
+ * literals are merged into one entry, and consecutive slices that are
+ * stored next to each other share one reference. Sub-messages
+ * that do not change between frames (system, camera_day,
+ * compass_calibration, ...) therefore cost a few bytes per frame, and
+ * frames rebuild byte-exactly by concatenating their slices. A payload
+ * that is not well-formed is stored as one literal from the point where
+ * splitting failed.
+ *
+ * Store file layout:
+ * @code
+ *   "JDDS0001"
+ *   frame*:  u32 body_len (little-endian)  body
+ *   body:    entry*
+ *   entry:   varint (len << 1 | 1)  len bytes          literal
+ *          | varint (distance << 1)  varint len          reference
+ * @endcode
+ * A reference's distance is counted back from the start of its frame to
+ * bytes inside an earlier literal. Frames are self-contained
+ * records, so a truncated file loses at most the last frame. Writer
+ * memory is bounded by the per-field slice cache.
+ */
+class DedupWriter
+{
+public:
+  static constexpr size_t RECENT_SLICES = 8; // Per field number
+  static constexpr size_t MIN_SLICE = 8;     // Shorter slices are inlined
+
+  DedupWriter () = default;
+
+  /**
+   * @brief Close the file
+   */
+  ~DedupWriter ();
+
+  // Non-copyable, non-movable
+  DedupWriter (const DedupWriter &) = delete;
+  DedupWriter &operator= (const DedupWriter &) = delete;
+  DedupWriter (DedupWriter &&) = delete;
+  DedupWriter &operator= (DedupWriter &&) = delete;
+
+  /**
+   * @brief Create the store file and write the header
+   * @param filename Output file path
+   * @return true if the file was created
+   */
+  bool open (const std::string &filename);
+
+  /**
+   * @brief Append one payload as the next frame
+   * @param data Raw payload
+   * @param len Payload length in bytes
+   * @return true if written
+   */
+  bool append (const uint8_t *data, size_t len);
+
+  /**
+   * @brief Flush and close the file
+   * @return true if every write succeeded
+   */
+  bool close ();
+
+  /**
+   * @brief Get the number of frames appended
+   * @return Frame count
+   */
+  uint64_t frames () const { return frames_; }
+
+  /**
+   * @brief Get the total size of the payloads appended
+   * @return Bytes before deduplication
+   */
+  uint64_t raw_bytes () const { return raw_bytes_; }
+
+  /**
+   * @brief Get the size of the store file
+   * @return Bytes written, header included
+   */
+  uint64_t stored_bytes () const { return position_; }
+
+private:
+  struct Slice
+  {
+    uint64_t hash = 0;
+    uint64_t offset = 0; // File offset of the bytes (UNPLACED while
+                         // their literal is being built)
+    std::vector<uint8_t> bytes;
+  };
+
+  struct Recent
+  {
+    std::array<Slice, RECENT_SLICES> slices;
+    size_t next = 0;
+  };
+
+  static constexpr uint64_t UNPLACED = UINT64_MAX;
+
+  void add_slice (uint32_t field, const uint8_t *data, size_t len);
+  void flush_pending ();
+
+  std::ofstream file_;
+  std::unordered_map<uint32_t, Recent> recent_;
+  std::vector<uint8_t> body_; // Frame being encoded
+  uint64_t frame_start_ = 0;  // File offset of the frame being encoded
+  uint64_t pending_offset_ = 0; // Reference being extended while the
+  uint64_t pending_len_ = 0;    // slices it covers stay contiguous
+  std::vector<uint8_t> literal_; // Literal being extended
+  std::vector<std::pair<Slice *, size_t>> unplaced_; // Cached slices in it
+  uint64_t position_ = 0;
+  uint64_t frames_ = 0;
+  uint64_t raw_bytes_ = 0;
+};
+
+/**
+ * @brief Describe a store's size against the raw payloads it holds
+ * @param writer Store
+ * @return E.g. "12.3 MB raw -> 1.2 MB stored (10.3x)"
+ */
+std::string describe_store_size (const DedupWriter &writer);
+
+/**
+ * @brief Random access to the frames of a DedupWriter store
+ *
+ * Maps the file read-only and indexes frame offsets once at open (8
+ * bytes per frame); read() then rebuilds any frame by copying its
+ * literals and referenced slices out of the mapping.
+ */
+class DedupReader
+{
+public:
+  DedupReader () = default;
+
+  /**
+   * @brief Unmap the file
+   */
+  ~DedupReader ();
+
+  // Non-copyable, non-movable
+  DedupReader (const DedupReader &) = delete;
+  DedupReader &operator= (const DedupReader &) = delete;
+  DedupReader (DedupReader &&) = delete;
+  DedupReader &operator= (DedupReader &&) = delete;
+
+  /**
+   * @brief Check whether a file starts with the store header
+   * @param filename File path
+   * @return true for a store file
+   */
+  static bool is_store (const std::string &filename);
+
+  /**
+   * @brief Check whether data starts with the store header
+   * @param data File contents
+   * @param len Length in bytes
+   * @return true for a store file
+   */
+  static bool is_store (const uint8_t *data, size_t len);
+
+  /**
+   * @brief Map a store file and index its frames
+   *
+   * An incomplete last frame (interrupted capture) is ignored.
+   *
+   * @param filename Store file path
+   * @return true if the file is a store
+   */
+  bool open (const std::string &filename);
+
+  /**
+   * @brief Get the number of complete frames
+   * @return Frame count
+   */
+  size_t frame_count () const { return frames_.size (); }
+
+  /**
+   * @brief Rebuild one frame
+   * @param index Frame index, from 0
+   * @param payload Receives the original payload
+   * @return false if the index is out of range or the frame is corrupt
+   */
+  bool read (size_t index, std::vector<uint8_t> &payload) const;
+
+private:
+  void unmap ();
+
+  const uint8_t *data_ = nullptr;
+  size_t size_ = 0;
+  std::vector<uint64_t> frames_; // Offset of each frame's body_len
+};
+
+} // namespace jettison
+
+#endif // DEDUP_STORE_H
@@ -2,10 +2,11 @@
 // Copyright (C) 2025 Jettison Project Team
 
 #include "dump_manager.h"
+#include "dedup_store.h"
+#include "logger.h"
 #include <cstdio>
 #include <fstream>
 #include <iomanip>
-#include <iostream>
 #include <sstream>
 #include <sys/stat.h>
 #include <sys/types.h>
@@ -17,6 +18,44 @@ DumpManager::DumpManager (const std::string &dump_dir) : dump_dir_ (dump_dir)
 {
 }
 
+DumpManager::~DumpManager () = default;
+
+bool
+DumpManager::open_store (const std::string &path)
+{
+  if (store_ && store_path_ == path)
+    {
+      return true;
+    }
+  auto store = std::make_unique<DedupReader> ();
+  if (!store->open (path))
+    {
+      return false;
+    }
+  store_ = std::move (store);
+  store_path_ = path;
+  return true;
+}
+
+std::vector<std::string>
+DumpManager::expand_dumps (const std::vector<std::string> &filenames)
+{
+  std::vector<std::string> expanded;
+  for (const auto &filename : filenames)
+    {
+      if (!DedupReader::is_store (filename) || !open_store (filename))
+        {
+          expanded.push_back (filename);
+          continue;
+        }
+      for (size_t i = 1; i <= store_->frame_count (); ++i)
+        {
+          expanded.push_back (filename + "#" + std::to_string (i));
+        }
+    }
+  return expanded;
+}
+
 bool
 DumpManager::ensure_dump_dir_exists ()
 {
@@ -40,7 +79,7 @@ DumpManager::save_dump (const uint8_t *data, size_t len, int sequence_number)
 {
   if (!ensure_dump_dir_exists ())
     {
-      std::cerr << "Failed to create dump directory: " << dump_dir_ << "\n";
+      log_error ("Failed to create dump directory: ", dump_dir_);
       return false;
     }
 
@@ -52,8 +91,7 @@ DumpManager::save_dump (const uint8_t *data, size_t len, int sequence_number)
   std::ofstream file (filename.str (), std::ios::binary);
   if (!file.is_open ())
     {
-      std::cerr << "Failed to open file for writing: " << filename.str ()
-                << "\n";
+      log_error ("Failed to open file for writing: ", filename.str ());
       return false;
     }
 
@@ -63,28 +101,51 @@ DumpManager::save_dump (const uint8_t *data, size_t len, int sequence_number)
 
   if (!file.good ())
     {
-      std::cerr << "Error writing to file: " << filename.str () << "\n";
+      log_error ("Error writing to file: ", filename.str ());
       return false;
     }
 
-  std::cout << "Saved dump to: " << filename.str () << "\n";
+  log_info ("Saved dump to: ", filename.str ());
   return true;
 }
 
 std::vector<uint8_t>
 DumpManager::read_dump (const std::string &filename)
 {
+  // store.jdd#N: frame N of a dump store
+  const size_t hash = filename.rfind ('#');
+  const size_t digits = filename.size () - hash - 1;
+  if (hash != std::string::npos && digits > 0 && digits < 10
+      && filename.find_first_not_of ("0123456789", hash + 1)
+             == std::string::npos)
+    {
+      const std::string store = filename.substr (0, hash);
+      if ((store_ && store_path_ == store) || DedupReader::is_store (store))
+        {
+          std::vector<uint8_t> data;
+          const size_t frame = std::stoul (filename.substr (hash + 1));
+          if (!open_store (store) || frame == 0
+              || !store_->read (frame - 1, data))
+            {
+              log_error ("Failed to read frame ", frame, " of dump store ",
+                         store);
+              return {};
+            }
+          return data;
+        }
+    }
+
   std::ifstream file (filename, std::ios::binary | std::ios::ate);
   if (!file.is_open ())
     {
-      std::cerr << "Failed to open file: " << filename << "\n";
+      log_error ("Failed to open file: ", filename);
       return {};
     }
 
   auto size = file.tellg ();
   if (size <= 0)
     {
-      std::cerr << "Invalid file size: " << filename << "\n";
+      log_error ("Invalid file size: ", filename);
       return {};
     }
 
@@ -96,7 +157,13 @@ DumpManager::read_dump (const std::string &filename)
 
   if (!file.good ())
     {
-      std::cerr << "Error reading file: " << filename << "\n";
+      log_error ("Error reading file: ", filename);
+      return {};
+    }
+  if (DedupReader::is_store (data.data (), data.size ()))
+    {
+      log_error (filename, " is a dump store; read frames as ", filename,
+                 "#N");
       return {};
     }
 
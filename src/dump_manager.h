@@ -6,6 +6,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <optional>
 #include <string>
 #include <vector>
@@ -13,11 +14,14 @@
 namespace jettison
 {
 
+class DedupReader;
+
 /**
  * @brief Manager for dumping and reading protobuf message payloads
  *
  * Saves raw binary protobuf messages to files for later inspection
- * and validation.
+ * and validation. Frames of a dump store (see DedupWriter) are read like
+ * dump files, as "store.jdd#N".
  */
 class DumpManager
 {
@@ -27,6 +31,7 @@ public:
    * @param dump_dir Directory to save dumps (default: "dumps")
    */
   explicit DumpManager (const std::string &dump_dir = "dumps");
+  ~DumpManager ();
 
   /**
    * @brief Save a binary payload to a numbered dump file
@@ -39,11 +44,23 @@ public:
 
   /**
    * @brief Read a dump file
+   *
+   * "store.jdd#N" reads frame N (from 1) of a dump store; the store
+   * stays mapped for the next read.
+   *
    * @param filename Path to dump file
    * @return Binary data if successful, empty vector otherwise
    */
   std::vector<uint8_t> read_dump (const std::string &filename);
 
+  /**
+   * @brief Expand dump stores in a file list into one entry per frame
+   * @param filenames Dump files and/or dump stores
+   * @return Dump files unchanged, each store as store#1 ... store#N
+   */
+  std::vector<std::string>
+  expand_dumps (const std::vector<std::string> &filenames);
+
   /**
    * @brief Ensure dump directory exists
    * @return true if directory exists or was created successfully
@@ -57,7 +74,11 @@ public:
   const std::string &get_dump_dir () const { return dump_dir_; }
 
 private:
+  bool open_store (const std::string &path);
+
   std::string dump_dir_;
+  std::unique_ptr<DedupReader> store_; // Last store read from
+  std::string store_path_;
 };
 
 } // namespace jettison
@@ -0,0 +1,336 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 Jettison Project Team
+
+#include "field_accessor.h"
+#include "buf/validate/validate.pb.h"
+#include <cmath>
+#include <limits>
+#include <numbers>
+#include <sstream>
+
+namespace jettison
+{
+
+using google::protobuf::Descriptor;
+using google::protobuf::FieldDescriptor;
+using google::protobuf::Message;
+
+static bool
+is_numeric (const FieldDescriptor *field)
+{
+  switch (field->cpp_type ())
+    {
+    case FieldDescriptor::CPPTYPE_INT32:
+    case FieldDescriptor::CPPTYPE_INT64:
+    case FieldDescriptor::CPPTYPE_UINT32:
+    case FieldDescriptor::CPPTYPE_UINT64:
+    case FieldDescriptor::CPPTYPE_DOUBLE:
+    case FieldDescriptor::CPPTYPE_FLOAT:
+    case FieldDescriptor::CPPTYPE_BOOL:
+    case FieldDescriptor::CPPTYPE_ENUM:
+      return true;
+    case FieldDescriptor::CPPTYPE_STRING:
+    case FieldDescriptor::CPPTYPE_MESSAGE:
+      return false;
+    default:
+      return false;
+    }
+}
+
+std::optional<FieldAccessor>
+FieldAccessor::resolve (const std::string &path, std::string *error,
+                        const Descriptor *root)
+{
+  auto fail = [&] (const std::string &reason) {
+    if (error != nullptr)
+      {
+        *error = reason;
+      }
+    return std::nullopt;
+  };
+
+  std::vector<const FieldDescriptor *> chain;
+  const Descriptor *current = root;
+  std::istringstream parts (path);
+  std::string name;
+
+  while (std::getline (parts, name, '.'))
+    {
+      if (current == nullptr)
+        {
+          return fail ("'" + chain.back ()->name () + "' has no sub-fields");
+        }
+      const FieldDescriptor *field = current->FindFieldByName (name);
+      if (field == nullptr)
+        {
+          return fail ("no field '" + name + "' in "
+                       + std::string (current->full_name ()));
+        }
+      if (field->is_repeated ())
+        {
+          return fail ("'" + name + "' is repeated");
+        }
+      chain.push_back (field);
+      current = field->cpp_type () == FieldDescriptor::CPPTYPE_MESSAGE
+                    ? field->message_type ()
+                    : nullptr;
+    }
+
+  if (chain.empty ())
+    {
+      return fail ("empty field path");
+    }
+  if (!is_numeric (chain.back ()))
+    {
+      return fail ("'" + path + "' is not a numeric, bool or enum field");
+    }
+
+  return FieldAccessor (path, std::move (chain));
+}
+
+static void
+collect_leaves (const Descriptor *type, const std::string &prefix,
+                std::vector<FieldAccessor> &out,
+                std::vector<const Descriptor *> &visiting)
+{
+  visiting.push_back (type);
+  for (int i = 0; i < type->field_count (); ++i)
+    {
+      const FieldDescriptor *field = type->field (i);
+      if (field->is_repeated ())
+        {
+          continue;
+        }
+      const std::string path = prefix + std::string (field->name ());
+
+      if (field->cpp_type () == FieldDescriptor::CPPTYPE_MESSAGE)
+        {
+          const Descriptor *sub = field->message_type ();
+          bool recursive = false;
+          for (const Descriptor *seen : visiting)
+            {
+              recursive = recursive || seen == sub;
+            }
+          if (!recursive)
+            {
+              collect_leaves (sub, path + ".", out, visiting);
+            }
+          continue;
+        }
+
+      if (is_numeric (field))
+        {
+          auto accessor
+              = FieldAccessor::resolve (path, nullptr, visiting.front ());
+          if (accessor)
+            {
+              out.push_back (std::move (*accessor));
+            }
+        }
+    }
+  visiting.pop_back ();
+}
+
+std::vector<FieldAccessor>
+FieldAccessor::numeric_leaves (const Descriptor *root)
+{
+  std::vector<FieldAccessor> out;
+  std::vector<const Descriptor *> visiting;
+  collect_leaves (root, "", out, visiting);
+  return out;
+}
+
+/**
+ * @brief Read both bounds of a numeric rules message (DoubleRules, ...)
+ */
+template <typename Rules>
+static std::optional<FieldAccessor::Range>
+range_of (const Rules &rules)
+{
+  if ((!rules.has_gt () && !rules.has_gte ())
+      || (!rules.has_lt () && !rules.has_lte ()))
+    {
+      return std::nullopt;
+    }
+
+  FieldAccessor::Range range{};
+  range.min_inclusive = rules.has_gte ();
+  range.min = static_cast<double> (rules.has_gte () ? rules.gte ()
+                                                    : rules.gt ());
+  range.max_inclusive = rules.has_lte ();
+  range.max = static_cast<double> (rules.has_lte () ? rules.lte ()
+                                                    : rules.lt ());
+  return range;
+}
+
+std::optional<FieldAccessor::Range>
+FieldAccessor::declared_range () const
+{
+  const auto &options = chain_.back ()->options ();
+  if (!options.HasExtension (buf::validate::field))
+    {
+      return std::nullopt;
+    }
+
+  const auto &rules = options.GetExtension (buf::validate::field);
+  if (rules.has_double_ ())
+    {
+      return range_of (rules.double_ ());
+    }
+  if (rules.has_float_ ())
+    {
+      return range_of (rules.float_ ());
+    }
+  if (rules.has_int32 ())
+    {
+      return range_of (rules.int32 ());
+    }
+  if (rules.has_int64 ())
+    {
+      return range_of (rules.int64 ());
+    }
+  if (rules.has_uint32 ())
+    {
+      return range_of (rules.uint32 ());
+    }
+  if (rules.has_uint64 ())
+    {
+      return range_of (rules.uint64 ());
+    }
+  return std::nullopt;
+}
+
+double
+FieldAccessor::wrap_period () const
+{
+  const auto range = declared_range ();
+  if (!range || !range->min_inclusive || range->max_inclusive)
+    {
+      return 0.0;
+    }
+
+  const double span = range->max - range->min;
+  for (const double turn : { 360.0, 2.0 * std::numbers::pi })
+    {
+      if (std::fabs (span - turn) <= 1e-9 * turn)
+        {
+          return turn;
+        }
+    }
+  return 0.0;
+}
+
+const Message &
+FieldAccessor::leaf_message (const Message &message) const
+{
+  const Message *current = &message;
+  for (size_t i = 0; i + 1 < chain_.size (); ++i)
+    {
+      current = &current->GetReflection ()->GetMessage (*current, chain_[i]);
+    }
+  return *current;
+}
+
+double
+FieldAccessor::get (const Message &message) const
+{
+  const Message *current = &leaf_message (message);
+  const FieldDescriptor *leaf = chain_.back ();
+  const auto *reflection = current->GetReflection ();
+  switch (leaf->cpp_type ())
+    {
+    case FieldDescriptor::CPPTYPE_INT32:
+      return reflection->GetInt32 (*current, leaf);
+    case FieldDescriptor::CPPTYPE_INT64:
+      return static_cast<double> (reflection->GetInt64 (*current, leaf));
+    case FieldDescriptor::CPPTYPE_UINT32:
+      return reflection->GetUInt32 (*current, leaf);
+    case FieldDescriptor::CPPTYPE_UINT64:
+      return static_cast<double> (reflection->GetUInt64 (*current, leaf));
+    case FieldDescriptor::CPPTYPE_DOUBLE:
+      return reflection->GetDouble (*current, leaf);
+    case FieldDescriptor::CPPTYPE_FLOAT:
+      return static_cast<double> (reflection->GetFloat (*current, leaf));
+    case FieldDescriptor::CPPTYPE_BOOL:
+      return reflection->GetBool (*current, leaf) ? 1.0 : 0.0;
+    case FieldDescriptor::CPPTYPE_ENUM:
+      return reflection->GetEnumValue (*current, leaf);
+    case FieldDescriptor::CPPTYPE_STRING:
+    case FieldDescriptor::CPPTYPE_MESSAGE:
+      return 0.0;
+    default:
+      return 0.0;
+    }
+}
+
+int64_t
+FieldAccessor::get_int64 (const Message &message) const
+{
+  const Message &current = leaf_message (message);
+  const FieldDescriptor *leaf = chain_.back ();
+  const auto *reflection = current.GetReflection ();
+  switch (leaf->cpp_type ())
+    {
+    case FieldDescriptor::CPPTYPE_INT32:
+      return reflection->GetInt32 (current, leaf);
+    case FieldDescriptor::CPPTYPE_INT64:
+      return reflection->GetInt64 (current, leaf);
+    case FieldDescriptor::CPPTYPE_UINT32:
+      return reflection->GetUInt32 (current, leaf);
+    case FieldDescriptor::CPPTYPE_UINT64:
+      return static_cast<int64_t> (reflection->GetUInt64 (current, leaf));
+    case FieldDescriptor::CPPTYPE_BOOL:
+      return reflection->GetBool (current, leaf) ? 1 : 0;
+    case FieldDescriptor::CPPTYPE_ENUM:
+      return reflection->GetEnumValue (current, leaf);
+    case FieldDescriptor::CPPTYPE_DOUBLE:
+    case FieldDescriptor::CPPTYPE_FLOAT:
+      {
+        // 2^63 is the first double out of range; NaN fails both tests
+        const double value = get (message);
+        if (value >= 0x1p63)
+          {
+            return std::numeric_limits<int64_t>::max ();
+          }
+        if (value >= -0x1p63)
+          {
+            return static_cast<int64_t> (value);
+          }
+        return std::isnan (value) ? 0 : std::numeric_limits<int64_t>::min ();
+      }
+    case FieldDescriptor::CPPTYPE_STRING:
+    case FieldDescriptor::CPPTYPE_MESSAGE:
+    default:
+      return 0;
+    }
+}
+
+uint64_t
+FieldAccessor::get_uint64 (const Message &message) const
+{
+  const Message &current = leaf_message (message);
+  const FieldDescriptor *leaf = chain_.back ();
+  const auto *reflection = current.GetReflection ();
+  switch (leaf->cpp_type ())
+    {
+    case FieldDescriptor::CPPTYPE_UINT32:
+      return reflection->GetUInt32 (current, leaf);
+    case FieldDescriptor::CPPTYPE_UINT64:
+      return reflection->GetUInt64 (current, leaf);
+    case FieldDescriptor::CPPTYPE_DOUBLE:
+    case FieldDescriptor::CPPTYPE_FLOAT:
+      {
+        // 2^64 is the first double out of range; NaN fails both tests
+        const double value = get (message);
+        if (value >= 0x1p64)
+          {
+            return std::numeric_limits<uint64_t>::max ();
+          }
+        return value > 0.0 ? static_cast<uint64_t> (value) : 0;
+      }
+    default:
+      return static_cast<uint64_t> (get_int64 (message));
+    }
+}
+
+} // namespace jettison
@@ -0,0 +1,151 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 Jettison Project Team
+
+#ifndef FIELD_ACCESSOR_H
+#define FIELD_ACCESSOR_H
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <google/protobuf/descriptor.h>
+#include <google/protobuf/message.h>
+
+#include "jon_shared_data.pb.h"
+
+namespace jettison
+{
+
+/**
+ * @brief Precomputed accessor for a scalar field path such as
+ * "compass.azimuth"
+ *
+ * The path is resolved to a chain of field descriptors once, so reading
+ * a value per frame costs a few reflection getters and no name lookups.
+ * Unset sub-messages read as their defaults, like the generated getters.
+ */
+class FieldAccessor
+{
+public:
+  /**
+   * @brief Value range declared with buf.validate rules
+   */
+  struct Range
+  {
+    double min;
+    double max;
+    bool min_inclusive; // gte rather than gt
+    bool max_inclusive; // lte rather than lt
+  };
+
+  /**
+   * @brief Resolve a dotted path of singular fields
+   *
+   * Leaves must be numeric, bool or enum (read as 0/1 and enum numbers).
+   *
+   * @param path Dotted field path relative to root
+   * @param error Receives the reason on failure (may be nullptr)
+   * @param root Message type the path starts from
+   * @return Accessor, or std::nullopt if the path does not resolve
+   */
+  static std::optional<FieldAccessor>
+  resolve (const std::string &path, std::string *error = nullptr,
+           const google::protobuf::Descriptor *root
+           = ser::JonGUIState::descriptor ());
+
+  /**
+   * @brief Enumerate every numeric leaf reachable from a message type
+   *
+   * Repeated fields and recursive types are skipped.
+   *
+   * @param root Message type to walk
+   * @return Accessors in field declaration order
+   */
+  static std::vector<FieldAccessor>
+  numeric_leaves (const google::protobuf::Descriptor *root
+                  = ser::JonGUIState::descriptor ());
+
+  /**
+   * @brief Read the field as a number
+   * @param message Message of the root type
+   * @return Field value (bool and enum as numbers)
+   */
+  double get (const google::protobuf::Message &message) const;
+
+  /**
+   * @brief Read the field as a signed integer, without going through a
+   * double
+   *
+   * Integer, bool and enum leaves are exact (a uint64 above INT64_MAX
+   * wraps; use get_uint64() for those). Floating-point leaves are
+   * truncated and saturated, NaN reads as 0.
+   *
+   * @param message Message of the root type
+   * @return Field value
+   */
+  int64_t get_int64 (const google::protobuf::Message &message) const;
+
+  /**
+   * @brief Read the field as an unsigned integer, without going through a
+   * double
+   *
+   * Integer, bool and enum leaves are exact (negative values wrap).
+   * Floating-point leaves are truncated and saturated, NaN and negative
+   * values read as 0.
+   *
+   * @param message Message of the root type
+   * @return Field value
+   */
+  uint64_t get_uint64 (const google::protobuf::Message &message) const;
+
+  /**
+   * @brief Get the leaf's range from its buf.validate rules
+   * @return Range, or std::nullopt unless both bounds are declared
+   */
+  std::optional<Range> declared_range () const;
+
+  /**
+   * @brief Get the wrap-around period of an angle field
+   *
+   * Only a declared range covering exactly one turn, closed below and
+   * open above such as [0, 360), [-180, 180) or [0, 2π), is taken as an
+   * angle; other half-open ranges such as (0, 1000] do not wrap.
+   *
+   * @return Period (360 or 2π), or 0 if the field does not wrap
+   */
+  double wrap_period () const;
+
+  /**
+   * @brief Get the dotted path this accessor was resolved from
+   * @return Field path
+   */
+  const std::string &path () const { return path_; }
+
+  /**
+   * @brief Get the descriptors from the root to the leaf
+   * @return Field descriptor chain (leaf last)
+   */
+  const std::vector<const google::protobuf::FieldDescriptor *> &
+  chain () const
+  {
+    return chain_;
+  }
+
+private:
+  const google::protobuf::Message &
+  leaf_message (const google::protobuf::Message &message) const;
+
+  FieldAccessor (std::string path,
+                 std::vector<const google::protobuf::FieldDescriptor *> chain)
+      : path_ (std::move (path)), chain_ (std::move (chain))
+  {
+  }
+
+  std::string path_;
+  std::vector<const google::protobuf::FieldDescriptor *> chain_;
+};
+
+} // namespace jettison
+
+#endif // FIELD_ACCESSOR_H
@@ -0,0 +1,97 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 Jettison Project Team
+
+#include "field_watcher.h"
+#include <cmath>
+
+namespace jettison
+{
+
+std::optional<FieldWatchSpec>
+parse_watch_spec (const std::string &spec)
+{
+  FieldWatchSpec result;
+  const size_t first = spec.find (':');
+  result.path = spec.substr (0, first);
+  if (first == std::string::npos)
+    {
+      return result;
+    }
+
+  const size_t second = spec.find (':', first + 1);
+  try
+    {
+      result.deadband = std::stod (spec.substr (first + 1, second - first - 1));
+      if (second != std::string::npos)
+        {
+          result.period = std::stod (spec.substr (second + 1));
+        }
+    }
+  catch (...)
+    {
+      return std::nullopt;
+    }
+
+  if (result.deadband < 0.0 || result.period < 0.0)
+    {
+      return std::nullopt;
+    }
+  return result;
+}
+
+bool
+FieldWatcher::add (const FieldWatchSpec &spec, std::string *error)
+{
+  auto accessor = FieldAccessor::resolve (spec.path, error);
+  if (!accessor)
+    {
+      return false;
+    }
+  watches_.push_back (
+      Watch{ std::move (*accessor), spec.deadband, spec.period, 0.0, false });
+  return true;
+}
+
+void
+FieldWatcher::set_callback (ChangeCallback callback)
+{
+  callback_ = std::move (callback);
+}
+
+size_t
+FieldWatcher::update (const ser::JonGUIState &state)
+{
+  size_t changes = 0;
+  for (auto &watch : watches_)
+    {
+      const double current = watch.accessor.get (state);
+
+      const bool initial = !watch.has_value;
+      if (!initial)
+        {
+          double delta = current - watch.reported;
+          if (watch.period > 0.0)
+            {
+              // Shortest way around, e.g. 359.9 -> 0.1 is 0.2 degrees
+              delta = std::remainder (delta, watch.period);
+            }
+          if (!(std::fabs (delta) > watch.deadband))
+            {
+              continue;
+            }
+        }
+
+      const FieldChange change{ watch.accessor.path (), watch.reported,
+                                current, initial };
+      watch.reported = current;
+      watch.has_value = true;
+      changes++;
+      if (callback_)
+        {
+          callback_ (change);
+        }
+    }
+  return changes;
+}
+
+} // namespace jettison
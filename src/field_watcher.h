@@ -0,0 +1,102 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 Jettison Project Team
+
+#ifndef FIELD_WATCHER_H
+#define FIELD_WATCHER_H
+
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "field_accessor.h"
+#include "jon_shared_data.pb.h"
+
+namespace jettison
+{
+
+/**
+ * @brief A field to watch and how much it must move to count as a change
+ */
+struct FieldWatchSpec
+{
+  std::string path;      // Dotted field path, e.g. "compass.azimuth"
+  double deadband = 0.0; // Minimum change to report (0 = any change)
+  double period = 0.0;   // Wrap-around period, e.g. 360 for angles (0 = none)
+};
+
+/**
+ * @brief Parse "path[:deadband[:period]]"
+ * @param spec Watch specification
+ * @return Parsed spec, or std::nullopt if a number is malformed
+ */
+std::optional<FieldWatchSpec> parse_watch_spec (const std::string &spec);
+
+/**
+ * @brief A reported change of one watched field
+ */
+struct FieldChange
+{
+  const std::string &path; // Watched field path
+  double previous;         // Last reported value (undefined if initial)
+  double current;          // New value
+  bool initial;            // First value seen, not a change
+};
+
+/**
+ * @brief Reports watched fields only when they move past their deadband
+ *
+ * Each state is compared with the last *reported* value of every watched
+ * field, so slow drift is reported once it accumulates past the deadband.
+ * One watcher follows one stream; use one per target.
+ */
+class FieldWatcher
+{
+public:
+  using ChangeCallback = std::function<void (const FieldChange &change)>;
+
+  /**
+   * @brief Add a field to watch
+   * @param spec Field path and thresholds
+   * @param error Receives the reason on failure (may be nullptr)
+   * @return false if the path does not resolve to a numeric field
+   */
+  bool add (const FieldWatchSpec &spec, std::string *error = nullptr);
+
+  /**
+   * @brief Set the callback for reported changes
+   * @param callback Function called once per qualifying change
+   */
+  void set_callback (ChangeCallback callback);
+
+  /**
+   * @brief Compare a new state against the last reported values
+   * @param state New state
+   * @return Number of changes reported
+   */
+  size_t update (const ser::JonGUIState &state);
+
+  /**
+   * @brief Get the number of watched fields
+   * @return Watch count
+   */
+  size_t size () const { return watches_.size (); }
+
+private:
+  struct Watch
+  {
+    FieldAccessor accessor;
+    double deadband;
+    double period;
+    double reported;
+    bool has_value;
+  };
+
+  std::vector<Watch> watches_;
+  ChangeCallback callback_;
+};
+
+} // namespace jettison
+
+#endif // FIELD_WATCHER_H
@@ -0,0 +1,274 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 Jettison Project Team
+
+#include "history_store.h"
+#include <algorithm>
+
+namespace jettison
+{
+
+namespace
+{
+
+constexpr int64_t NS_PER_SECOND = 1000000000;
+constexpr int64_t NS_PER_MINUTE = 60 * NS_PER_SECOND;
+
+int64_t
+floor_to (int64_t time_ns, int64_t width)
+{
+  const int64_t q = time_ns / width;
+  return (time_ns % width < 0 ? q - 1 : q) * width;
+}
+
+} // namespace
+
+HistoryStore::Tier::Tier (int64_t width, size_t field_count,
+                          size_t ring_capacity)
+    : width_ns (width), capacity (std::max<size_t> (ring_capacity, 1)),
+      time (capacity), count (capacity), min (field_count * capacity),
+      max (field_count * capacity), sum (field_count * capacity),
+      acc_min (field_count), acc_max (field_count), acc_sum (field_count)
+{
+}
+
+size_t
+HistoryStore::Tier::slot (size_t logical) const
+{
+  return (head + capacity - size + logical) % capacity;
+}
+
+void
+HistoryStore::Tier::close_open (size_t field_count)
+{
+  if (!open)
+    {
+      return;
+    }
+
+  const size_t s = head;
+  time[s] = open_start;
+  count[s] = open_count;
+  for (size_t f = 0; f < field_count; ++f)
+    {
+      min[f * capacity + s] = acc_min[f];
+      max[f * capacity + s] = acc_max[f];
+      sum[f * capacity + s] = acc_sum[f];
+    }
+
+  head = (head + 1) % capacity;
+  size = std::min (size + 1, capacity);
+  open = false;
+}
+
+void
+HistoryStore::Tier::add (const double *values, size_t field_count,
+                         int64_t time_ns)
+{
+  const int64_t start = floor_to (time_ns, width_ns);
+  if (open && start != open_start)
+    {
+      close_open (field_count);
+    }
+
+  if (!open)
+    {
+      open = true;
+      open_start = start;
+      open_count = 1;
+      std::copy (values, values + field_count, acc_min.begin ());
+      std::copy (values, values + field_count, acc_max.begin ());
+      std::copy (values, values + field_count, acc_sum.begin ());
+      return;
+    }
+
+  // Contiguous and branch-free: vectorized across fields
+  double *const lo = acc_min.data ();
+  double *const hi = acc_max.data ();
+  double *const total = acc_sum.data ();
+  for (size_t f = 0; f < field_count; ++f)
+    {
+      lo[f] = values[f] < lo[f] ? values[f] : lo[f];
+      hi[f] = values[f] > hi[f] ? values[f] : hi[f];
+      total[f] += values[f];
+    }
+  open_count++;
+}
+
+size_t
+HistoryStore::Tier::first_slot_from (int64_t from_ns) const
+{
+  // First bucket ending after from_ns; bucket times increase along the ring
+  size_t lo = 0;
+  size_t hi = size;
+  while (lo < hi)
+    {
+      const size_t mid = (lo + hi) / 2;
+      if (time[slot (mid)] + width_ns <= from_ns)
+        {
+          lo = mid + 1;
+        }
+      else
+        {
+          hi = mid;
+        }
+    }
+  return lo;
+}
+
+size_t
+HistoryStore::Tier::bytes () const
+{
+  return time.size () * sizeof (int64_t) + count.size () * sizeof (uint32_t)
+         + (min.size () + max.size () + sum.size () + acc_min.size ()
+            + acc_max.size () + acc_sum.size ())
+               * sizeof (double);
+}
+
+HistoryStore::HistoryStore (std::vector<FieldAccessor> fields, Config config)
+    : fields_ (std::move (fields)), scratch_ (fields_.size ()),
+      raw_capacity_ (std::max<size_t> (config.raw_capacity, 1)),
+      raw_time_ (raw_capacity_), raw_values_ (fields_.size () * raw_capacity_),
+      seconds_ (NS_PER_SECOND, fields_.size (), config.second_capacity),
+      minutes_ (NS_PER_MINUTE, fields_.size (), config.minute_capacity)
+{
+}
+
+std::optional<HistoryStore::Resolution>
+HistoryStore::parse_resolution (const std::string &name)
+{
+  if (name == "raw")
+    {
+      return Resolution::Raw;
+    }
+  if (name == "1s")
+    {
+      return Resolution::Second;
+    }
+  if (name == "1m")
+    {
+      return Resolution::Minute;
+    }
+  return std::nullopt;
+}
+
+void
+HistoryStore::record (const ser::JonGUIState &state, int64_t time_ns)
+{
+  const size_t field_count = fields_.size ();
+  for (size_t f = 0; f < field_count; ++f)
+    {
+      scratch_[f] = fields_[f].get (state);
+    }
+
+  std::lock_guard<std::mutex> lock (mutex_);
+  time_ns = std::max (time_ns, last_time_);
+  last_time_ = time_ns;
+
+  raw_time_[raw_head_] = time_ns;
+  for (size_t f = 0; f < field_count; ++f)
+    {
+      raw_values_[f * raw_capacity_ + raw_head_] = scratch_[f];
+    }
+  raw_head_ = (raw_head_ + 1) % raw_capacity_;
+  raw_size_ = std::min (raw_size_ + 1, raw_capacity_);
+
+  seconds_.add (scratch_.data (), field_count, time_ns);
+  minutes_.add (scratch_.data (), field_count, time_ns);
+}
+
+std::vector<HistoryStore::Point>
+HistoryStore::query (size_t field, Resolution resolution, int64_t from_ns,
+                     int64_t to_ns) const
+{
+  std::vector<Point> points;
+  if (field >= fields_.size ())
+    {
+      return points;
+    }
+
+  std::lock_guard<std::mutex> lock (mutex_);
+
+  if (resolution == Resolution::Raw)
+    {
+      const double *values = raw_values_.data () + field * raw_capacity_;
+      auto raw_slot = [this] (size_t logical) {
+        return (raw_head_ + raw_capacity_ - raw_size_ + logical)
+               % raw_capacity_;
+      };
+
+      size_t lo = 0;
+      size_t hi = raw_size_;
+      while (lo < hi)
+        {
+          const size_t mid = (lo + hi) / 2;
+          if (raw_time_[raw_slot (mid)] < from_ns)
+            {
+              lo = mid + 1;
+            }
+          else
+            {
+              hi = mid;
+            }
+        }
+      for (size_t i = lo; i < raw_size_; ++i)
+        {
+          const size_t s = raw_slot (i);
+          if (raw_time_[s] > to_ns)
+            {
+              break;
+            }
+          points.push_back (
+              Point{ raw_time_[s], values[s], values[s], values[s], 1 });
+        }
+      return points;
+    }
+
+  const Tier &tier = resolution == Resolution::Second ? seconds_ : minutes_;
+  const size_t base = field * tier.capacity;
+  for (size_t i = tier.first_slot_from (from_ns); i < tier.size; ++i)
+    {
+      const size_t s = tier.slot (i);
+      if (tier.time[s] > to_ns)
+        {
+          break;
+        }
+      points.push_back (Point{ tier.time[s], tier.min[base + s],
+                               tier.max[base + s],
+                               tier.sum[base + s] / tier.count[s],
+                               tier.count[s] });
+    }
+
+  if (tier.open && tier.open_start <= to_ns
+      && tier.open_start + tier.width_ns > from_ns)
+    {
+      points.push_back (Point{ tier.open_start, tier.acc_min[field],
+                               tier.acc_max[field],
+                               tier.acc_sum[field] / tier.open_count,
+                               tier.open_count });
+    }
+
+  return points;
+}
+
+std::optional<size_t>
+HistoryStore::field_index (const std::string &path) const
+{
+  for (size_t i = 0; i < fields_.size (); ++i)
+    {
+      if (fields_[i].path () == path)
+        {
+          return i;
+        }
+    }
+  return std::nullopt;
+}
+
+size_t
+HistoryStore::memory_bytes () const
+{
+  return raw_time_.size () * sizeof (int64_t)
+         + (raw_values_.size () + scratch_.size ()) * sizeof (double)
+         + seconds_.bytes () + minutes_.bytes ();
+}
+
+} // namespace jettison
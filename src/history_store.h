@@ -0,0 +1,184 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 Jettison Project Team
+
+#ifndef HISTORY_STORE_H
+#define HISTORY_STORE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "field_accessor.h"
+#include "jon_shared_data.pb.h"
+
+namespace jettison
+{
+
+/**
+ * @brief Fixed-memory history of selected numeric fields
+ *
+ * Keeps recent samples at three resolutions, each in its own ring:
+ * raw samples, 1 s buckets and 1 min buckets (min/max/mean per bucket).
+ * Storage is struct-of-arrays (one contiguous array per field and
+ * statistic) and is allocated once in the constructor; recording never
+ * allocates, so memory stays fixed however long the receiver runs.
+ *
+ * Each frame updates the open 1 s and 1 min buckets of all fields with
+ * straight loops over contiguous per-field accumulators, which the
+ * compiler vectorizes. Recording and queries may run on different
+ * threads.
+ */
+class HistoryStore
+{
+public:
+  enum class Resolution
+  {
+    Raw,
+    Second,
+    Minute
+  };
+
+  /**
+   * @brief Ring sizes, fixed at construction
+   */
+  struct Config
+  {
+    size_t raw_capacity = 4096;    // Raw samples (about 1 min at 60 Hz)
+    size_t second_capacity = 3600; // 1 s buckets (1 hour)
+    size_t minute_capacity = 1440; // 1 min buckets (1 day)
+  };
+
+  /**
+   * @brief One raw sample or bucket
+   *
+   * For raw samples min, max and mean are the sample value and count is 1.
+   */
+  struct Point
+  {
+    int64_t time_ns; // Sample time, or bucket start
+    double min;
+    double max;
+    double mean;
+    uint32_t count; // Samples in the bucket
+  };
+
+  /**
+   * @brief Construct a store for the given fields
+   * @param fields Fields to keep history for
+   * @param config Ring sizes
+   */
+  explicit HistoryStore (std::vector<FieldAccessor> fields, Config config);
+  explicit HistoryStore (std::vector<FieldAccessor> fields)
+      : HistoryStore (std::move (fields), Config{})
+  {
+  }
+
+  /**
+   * @brief Parse "raw", "1s" or "1m"
+   * @param name Resolution name
+   * @return Resolution, or std::nullopt if unknown
+   */
+  static std::optional<Resolution> parse_resolution (const std::string &name);
+
+  /**
+   * @brief Record one frame
+   *
+   * Times should not go backwards; an earlier time is treated as equal to
+   * the latest one.
+   *
+   * @param state Parsed state
+   * @param time_ns Sample time in ns (any epoch, used consistently)
+   */
+  void record (const ser::JonGUIState &state, int64_t time_ns);
+
+  /**
+   * @brief Get the points of one field within a time range
+   *
+   * Bucketed resolutions include the bucket still being filled.
+   *
+   * @param field Field index (see field_index())
+   * @param resolution Resolution to read
+   * @param from_ns Start of range (inclusive)
+   * @param to_ns End of range (inclusive)
+   * @return Points in time order
+   */
+  std::vector<Point> query (size_t field, Resolution resolution,
+                            int64_t from_ns, int64_t to_ns) const;
+
+  /**
+   * @brief Find the index of a field path
+   * @param path Dotted field path
+   * @return Index, or std::nullopt if the field is not stored
+   */
+  std::optional<size_t> field_index (const std::string &path) const;
+
+  /**
+   * @brief Get the stored fields
+   * @return Field accessors, by index
+   */
+  const std::vector<FieldAccessor> &fields () const { return fields_; }
+
+  /**
+   * @brief Get the memory reserved for samples and buckets
+   * @return Size in bytes
+   */
+  size_t memory_bytes () const;
+
+private:
+  /**
+   * @brief Ring of min/max/sum buckets plus the bucket being filled
+   *
+   * Ring arrays are field-major ([field * capacity + slot]) so a query
+   * over one field reads contiguous memory; accumulators are indexed by
+   * field so per-sample updates are contiguous across fields.
+   */
+  struct Tier
+  {
+    Tier (int64_t width, size_t field_count, size_t ring_capacity);
+
+    void add (const double *values, size_t field_count, int64_t time_ns);
+    void close_open (size_t field_count);
+    size_t first_slot_from (int64_t from_ns) const;
+    size_t slot (size_t logical) const;
+    size_t bytes () const;
+
+    int64_t width_ns;
+    size_t capacity;
+    size_t head = 0; // Next slot to write
+    size_t size = 0; // Closed buckets held
+    std::vector<int64_t> time;
+    std::vector<uint32_t> count;
+    std::vector<double> min;
+    std::vector<double> max;
+    std::vector<double> sum;
+
+    bool open = false;
+    int64_t open_start = 0;
+    uint32_t open_count = 0;
+    std::vector<double> acc_min;
+    std::vector<double> acc_max;
+    std::vector<double> acc_sum;
+  };
+
+  std::vector<FieldAccessor> fields_;
+  std::vector<double> scratch_; // Current frame's values, by field
+
+  size_t raw_capacity_;
+  size_t raw_head_ = 0;
+  size_t raw_size_ = 0;
+  std::vector<int64_t> raw_time_;
+  std::vector<double> raw_values_; // [field * raw_capacity_ + slot]
+
+  Tier seconds_;
+  Tier minutes_;
+  int64_t last_time_ = 0;
+
+  mutable std::mutex mutex_;
+};
+
+} // namespace jettison
+
+#endif // HISTORY_STORE_H
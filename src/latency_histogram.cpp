@@ -0,0 +1,85 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 Jettison Project Team
+
+#include "latency_histogram.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+namespace jettison
+{
+
+size_t
+LatencyHistogram::bucket_of (uint64_t ns)
+{
+  // Values below SUB_BUCKETS map 1:1; above, 3 bits below the top bit
+  // select the sub-bucket
+  if (ns < SUB_BUCKETS)
+    {
+      return static_cast<size_t> (ns);
+    }
+  const auto top = static_cast<size_t> (std::bit_width (ns) - 1);
+  const auto sub = static_cast<size_t> ((ns >> (top - 3)) & (SUB_BUCKETS - 1));
+  return (top - 2) * SUB_BUCKETS + sub;
+}
+
+uint64_t
+LatencyHistogram::upper_bound (size_t bucket)
+{
+  if (bucket < SUB_BUCKETS)
+    {
+      return bucket;
+    }
+  const size_t top = bucket / SUB_BUCKETS + 2;
+  const uint64_t sub = bucket % SUB_BUCKETS;
+  if (top >= 63)
+    {
+      return UINT64_MAX;
+    }
+  return ((SUB_BUCKETS + sub + 1) << (top - 3)) - 1;
+}
+
+void
+LatencyHistogram::record (int64_t ns)
+{
+  const uint64_t value = ns > 0 ? static_cast<uint64_t> (ns) : 0;
+  buckets_[bucket_of (value)]++;
+  count_++;
+  max_ = std::max (max_, value);
+}
+
+void
+LatencyHistogram::merge (const LatencyHistogram &other)
+{
+  for (size_t i = 0; i < BUCKETS; ++i)
+    {
+      buckets_[i] += other.buckets_[i];
+    }
+  count_ += other.count_;
+  max_ = std::max (max_, other.max_);
+}
+
+uint64_t
+LatencyHistogram::percentile (double fraction) const
+{
+  if (count_ == 0)
+    {
+      return 0;
+    }
+
+  const auto rank = static_cast<uint64_t> (
+      std::ceil (std::clamp (fraction, 0.0, 1.0)
+                 * static_cast<double> (count_)));
+  uint64_t seen = 0;
+  for (size_t i = 0; i < BUCKETS; ++i)
+    {
+      seen += buckets_[i];
+      if (seen >= std::max<uint64_t> (rank, 1))
+        {
+          return std::min (upper_bound (i), max_);
+        }
+    }
+  return max_;
+}
+
+} // namespace jettison
@@ -0,0 +1,70 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 Jettison Project Team
+
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace jettison
+{
+
+/**
+ * @brief Fixed-size log-linear histogram of durations in ns
+ *
+ * Each power of two is split into 8 linear sub-buckets, so any recorded
+ * value is reported within 12.5%. Recording is a few integer operations
+ * and never allocates, which keeps it usable on the hot path. Not
+ * thread-safe; keep one per thread and merge().
+ */
+class LatencyHistogram
+{
+public:
+  /**
+   * @brief Record one duration
+   * @param ns Duration in ns (negative values count as 0)
+   */
+  void record (int64_t ns);
+
+  /**
+   * @brief Add another histogram's samples to this one
+   * @param other Histogram to merge
+   */
+  void merge (const LatencyHistogram &other);
+
+  /**
+   * @brief Get a percentile
+   * @param fraction Quantile in [0, 1], e.g. 0.999
+   * @return Upper bound of the bucket holding it, in ns (0 if empty)
+   */
+  uint64_t percentile (double fraction) const;
+
+  /**
+   * @brief Get the number of samples
+   * @return Sample count
+   */
+  uint64_t count () const { return count_; }
+
+  /**
+   * @brief Get the largest sample
+   * @return Maximum in ns
+   */
+  uint64_t max () const { return max_; }
+
+private:
+  static constexpr size_t SUB_BUCKETS = 8;
+  static constexpr size_t BUCKETS = 64 * SUB_BUCKETS;
+
+  static size_t bucket_of (uint64_t ns);
+  static uint64_t upper_bound (size_t bucket);
+
+  std::array<uint64_t, BUCKETS> buckets_{};
+  uint64_t count_ = 0;
+  uint64_t max_ = 0;
+};
+
+} // namespace jettison
+
+#endif // LATENCY_HISTOGRAM_H
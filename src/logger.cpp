@@ -0,0 +1,553 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 Jettison Project Team
+
+#include "logger.h"
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+namespace jettison
+{
+
+namespace
+{
+
+// Record: u64 time_ns, u32 size (header included, multiple of 8),
+// u8 level, 3 bytes padding, then the arguments:
+//   u8 type  Text: u32 length, bytes | Signed/Unsigned/Real: 8 bytes
+//            Deferred: 8-byte formatter, u32 length, bytes
+constexpr size_t HEADER = 16;
+constexpr uint8_t WRAP = 0xFF; // Level of a record that skips to the wrap
+
+constexpr size_t
+align8 (size_t size)
+{
+  return (size + 7) & ~size_t{ 7 };
+}
+
+size_t
+encoded_size (const LogArg *args, size_t count)
+{
+  size_t size = HEADER;
+  for (size_t i = 0; i < count; ++i)
+    {
+      switch (args[i].type)
+        {
+        case LogArg::Type::Text:
+          size += 1 + sizeof (uint32_t) + args[i].text.size ();
+          break;
+        case LogArg::Type::Deferred:
+          size += 1 + sizeof (uint64_t) + sizeof (uint32_t)
+                  + args[i].text.size ();
+          break;
+        default:
+          size += 1 + sizeof (uint64_t);
+          break;
+        }
+    }
+  return align8 (size);
+}
+
+void
+encode (uint8_t *out, uint64_t time_ns, uint32_t size, uint8_t level,
+        const LogArg *args, size_t count)
+{
+  std::memcpy (out, &time_ns, sizeof time_ns);
+  std::memcpy (out + 8, &size, sizeof size);
+  out[12] = level;
+  uint8_t *p = out + HEADER;
+  for (size_t i = 0; i < count; ++i)
+    {
+      const LogArg &arg = args[i];
+      *p++ = static_cast<uint8_t> (arg.type);
+      if (arg.type == LogArg::Type::Deferred)
+        {
+          std::memcpy (p, &arg.formatter, sizeof arg.formatter);
+          p += sizeof (uint64_t);
+        }
+      if (arg.type == LogArg::Type::Text
+          || arg.type == LogArg::Type::Deferred)
+        {
+          const auto length = static_cast<uint32_t> (arg.text.size ());
+          std::memcpy (p, &length, sizeof length);
+          std::memcpy (p + sizeof length, arg.text.data (), length);
+          p += sizeof length + length;
+        }
+      else
+        {
+          // The union's members are all 8 bytes
+          std::memcpy (p, &arg.unsigned_integer, sizeof (uint64_t));
+          p += sizeof (uint64_t);
+        }
+    }
+  const auto used = static_cast<size_t> (p - out);
+  std::memset (p, 0, align8 (used) - used);
+}
+
+/**
+ * @brief Format a record's arguments into line
+ */
+void
+decode (const uint8_t *record, size_t size, std::string &line)
+{
+  line.clear ();
+  const uint8_t *p = record + HEADER;
+  const uint8_t *const end = record + size;
+  char number[32];
+  while (p < end)
+    {
+      if (*p == 0)
+        {
+          break; // Padding
+        }
+      const auto type = static_cast<LogArg::Type> (*p++);
+      if (type == LogArg::Type::Text)
+        {
+          uint32_t length = 0;
+          std::memcpy (&length, p, sizeof length);
+          line.append (reinterpret_cast<const char *> (p + sizeof length),
+                       length);
+          p += sizeof length + length;
+          continue;
+        }
+      if (type == LogArg::Type::Deferred)
+        {
+          LogArg::Formatter formatter = nullptr;
+          uint32_t length = 0;
+          std::memcpy (&formatter, p, sizeof formatter);
+          std::memcpy (&length, p + sizeof (uint64_t), sizeof length);
+          p += sizeof (uint64_t) + sizeof length;
+          formatter (std::string_view (reinterpret_cast<const char *> (p),
+                                       length),
+                     line);
+          p += length;
+          continue;
+        }
+
+      uint64_t bits = 0;
+      std::memcpy (&bits, p, sizeof bits);
+      p += sizeof bits;
+      switch (type)
+        {
+        case LogArg::Type::Signed:
+          {
+            int64_t value = 0;
+            std::memcpy (&value, &bits, sizeof value);
+            line.append (number,
+                         std::to_chars (number, number + sizeof number, value)
+                             .ptr);
+            break;
+          }
+        case LogArg::Type::Unsigned:
+          line.append (number,
+                       std::to_chars (number, number + sizeof number, bits)
+                           .ptr);
+          break;
+        case LogArg::Type::Real:
+          {
+            double value = 0.0;
+            std::memcpy (&value, &bits, sizeof value);
+            const int length
+                = std::snprintf (number, sizeof number, "%.12g", value);
+            line.append (number, static_cast<size_t> (length));
+            break;
+          }
+        case LogArg::Type::Text:
+        case LogArg::Type::Deferred:
+        default:
+          break;
+        }
+    }
+  line.push_back ('\n');
+}
+
+uint64_t
+now_ns ()
+{
+  return static_cast<uint64_t> (
+      std::chrono::duration_cast<std::chrono::nanoseconds> (
+          std::chrono::steady_clock::now ().time_since_epoch ())
+          .count ());
+}
+
+} // namespace
+
+/**
+ * @brief Single-producer, single-consumer ring of records
+ *
+ * Positions grow without wrapping; the byte index is position &
+ * (capacity - 1). A record never straddles the end: the producer skips
+ * the remainder (marking it with a WRAP record when there is room for a
+ * header).
+ */
+struct Logger::Buffer
+{
+  explicit Buffer (size_t size) : data (new uint8_t[size]), capacity (size)
+  {
+  }
+
+  std::unique_ptr<uint8_t[]> data;
+  size_t capacity;
+  alignas (64) std::atomic<uint64_t> head{ 0 }; // Written by the producer
+  alignas (64) std::atomic<uint64_t> tail{ 0 }; // Written by the consumer
+  std::atomic<uint64_t> dropped{ 0 };
+  std::atomic<uint64_t> oversized{ 0 }; // Included in dropped
+  uint64_t reported_oversized = 0;      // Consumer only
+  std::atomic<bool> retired{ false }; // Owning thread has exited
+};
+
+std::optional<LogLevel>
+parse_log_level (const std::string &name)
+{
+  if (name == "debug")
+    {
+      return LogLevel::Debug;
+    }
+  if (name == "info")
+    {
+      return LogLevel::Info;
+    }
+  if (name == "warning")
+    {
+      return LogLevel::Warning;
+    }
+  if (name == "error")
+    {
+      return LogLevel::Error;
+    }
+  return std::nullopt;
+}
+
+Logger &
+Logger::instance ()
+{
+  static Logger logger;
+  return logger;
+}
+
+Logger::Logger ()
+    : sink_ ([] (LogLevel level, std::string_view line) {
+        std::fwrite (line.data (), 1, line.size (),
+                     level >= LogLevel::Warning ? stderr : stdout);
+      })
+{
+}
+
+Logger::~Logger () { stop (); }
+
+void
+Logger::start (size_t buffer_bytes)
+{
+  if (running_.load ())
+    {
+      return;
+    }
+  buffer_bytes_ = 256;
+  while (buffer_bytes_ < buffer_bytes)
+    {
+      buffer_bytes_ <<= 1;
+    }
+  running_.store (true, std::memory_order_release);
+  thread_ = std::thread (&Logger::run, this);
+}
+
+void
+Logger::stop ()
+{
+  if (!running_.exchange (false))
+    {
+      return;
+    }
+  {
+    std::lock_guard<std::mutex> lock (wake_mutex_);
+    wake_.notify_one ();
+  }
+  thread_.join ();
+  // Records from threads that saw the logger running just before
+  drain ();
+}
+
+void
+Logger::flush ()
+{
+  if (!running_.load (std::memory_order_acquire))
+    {
+      std::fflush (stdout);
+      return;
+    }
+  std::unique_lock<std::mutex> lock (wake_mutex_);
+  const uint64_t request = ++flush_requested_;
+  wake_.notify_one ();
+  drained_.wait (lock, [&] {
+    return flush_done_ >= request || !running_.load ();
+  });
+}
+
+void
+Logger::set_level (LogLevel level)
+{
+  level_.store (level, std::memory_order_relaxed);
+}
+
+void
+Logger::set_sink (Sink sink)
+{
+  if (!running_.load ())
+    {
+      sink_ = std::move (sink);
+    }
+}
+
+LogStats
+Logger::stats () const
+{
+  LogStats stats;
+  stats.written = written_.load (std::memory_order_relaxed);
+  std::lock_guard<std::mutex> lock (buffers_mutex_);
+  stats.dropped = retired_dropped_;
+  stats.oversized = retired_oversized_;
+  for (const auto &buffer : buffers_)
+    {
+      stats.dropped += buffer->dropped.load (std::memory_order_relaxed);
+      stats.oversized += buffer->oversized.load (std::memory_order_relaxed);
+    }
+  return stats;
+}
+
+Logger::Buffer *
+Logger::thread_buffer ()
+{
+  // Marks the buffer retired when the thread exits, so the background
+  // thread can release it once drained
+  struct Owner
+  {
+    Buffer *buffer = nullptr;
+    ~Owner ()
+    {
+      if (buffer != nullptr)
+        {
+          buffer->retired.store (true, std::memory_order_release);
+        }
+    }
+  };
+  thread_local Owner owner;
+
+  if (owner.buffer == nullptr)
+    {
+      auto buffer = std::make_unique<Buffer> (buffer_bytes_);
+      owner.buffer = buffer.get ();
+      std::lock_guard<std::mutex> lock (buffers_mutex_);
+      buffers_.push_back (std::move (buffer));
+    }
+  return owner.buffer;
+}
+
+void
+Logger::write_args (LogLevel level, const LogArg *args, size_t count)
+{
+  const size_t size = encoded_size (args, count);
+  const auto level_byte = static_cast<uint8_t> (level);
+
+  if (!running_.load (std::memory_order_acquire))
+    {
+      thread_local std::vector<uint8_t> record;
+      thread_local std::string line;
+      record.resize (size);
+      encode (record.data (), 0, static_cast<uint32_t> (size), level_byte,
+              args, count);
+      decode (record.data (), size, line);
+      std::lock_guard<std::mutex> lock (sync_mutex_);
+      emit (level, line);
+      return;
+    }
+
+  Buffer &buffer = *thread_buffer ();
+  if (size > buffer.capacity / 4)
+    {
+      // Reported by the logger thread
+      buffer.oversized.fetch_add (1, std::memory_order_relaxed);
+      buffer.dropped.fetch_add (1, std::memory_order_relaxed);
+      return;
+    }
+
+  const uint64_t head = buffer.head.load (std::memory_order_relaxed);
+  const uint64_t tail = buffer.tail.load (std::memory_order_acquire);
+  const size_t offset = head & (buffer.capacity - 1);
+  const size_t contiguous = buffer.capacity - offset;
+  const size_t skip = contiguous < size ? contiguous : 0;
+  if (head + skip + size - tail > buffer.capacity)
+    {
+      buffer.dropped.fetch_add (1, std::memory_order_relaxed);
+      return;
+    }
+
+  uint8_t *const data = buffer.data.get ();
+  if (skip >= HEADER)
+    {
+      encode (data + offset, 0, static_cast<uint32_t> (skip), WRAP, nullptr,
+              0);
+    }
+  encode (data + ((head + skip) & (buffer.capacity - 1)), now_ns (),
+          static_cast<uint32_t> (size), level_byte, args, count);
+  buffer.head.store (head + skip + size, std::memory_order_release);
+}
+
+void
+Logger::emit (LogLevel level, std::string_view line)
+{
+  sink_ (level, line);
+  written_.fetch_add (1, std::memory_order_relaxed);
+}
+
+bool
+Logger::drain ()
+{
+  struct Entry
+  {
+    uint64_t time;
+    LogLevel level;
+    std::vector<uint8_t> record; // Empty when line is already set
+    std::string line;
+  };
+  static thread_local std::vector<Entry> batch;
+  size_t used = 0;
+
+  {
+    std::lock_guard<std::mutex> lock (buffers_mutex_);
+    for (auto it = buffers_.begin (); it != buffers_.end ();)
+      {
+        Buffer &buffer = **it;
+        const bool retired = buffer.retired.load (std::memory_order_acquire);
+        const uint64_t head = buffer.head.load (std::memory_order_acquire);
+        uint64_t tail = buffer.tail.load (std::memory_order_relaxed);
+        const uint8_t *const data = buffer.data.get ();
+
+        while (tail < head)
+          {
+            const size_t offset = tail & (buffer.capacity - 1);
+            if (buffer.capacity - offset < HEADER)
+              {
+                tail += buffer.capacity - offset;
+                continue;
+              }
+            const uint8_t *record = data + offset;
+            uint64_t time = 0;
+            uint32_t size = 0;
+            std::memcpy (&time, record, sizeof time);
+            std::memcpy (&size, record + 8, sizeof size);
+            tail += size;
+            if (record[12] == WRAP)
+              {
+                continue;
+              }
+
+            if (used == batch.size ())
+              {
+                batch.emplace_back ();
+              }
+            // Deferred formatters run after the lock is released, so
+            // only take a copy of the encoded record here
+            Entry &entry = batch[used++];
+            entry.time = time;
+            entry.level = static_cast<LogLevel> (record[12]);
+            entry.record.assign (record, record + size);
+          }
+        buffer.tail.store (tail, std::memory_order_release);
+
+        const uint64_t oversized
+            = buffer.oversized.load (std::memory_order_relaxed);
+        if (oversized != buffer.reported_oversized)
+          {
+            if (used == batch.size ())
+              {
+                batch.emplace_back ();
+              }
+            Entry &entry = batch[used++];
+            entry.time = now_ns ();
+            entry.level = LogLevel::Warning;
+            entry.record.clear ();
+            entry.line = "Logger: dropped "
+                         + std::to_string (oversized
+                                           - buffer.reported_oversized)
+                         + " messages larger than "
+                         + std::to_string (buffer.capacity / 4) + " bytes\n";
+            buffer.reported_oversized = oversized;
+          }
+
+        if (retired)
+          {
+            retired_dropped_ += buffer.dropped.load ();
+            retired_oversized_ += oversized;
+            it = buffers_.erase (it);
+          }
+        else
+          {
+            ++it;
+          }
+      }
+  }
+
+  // Each ring is already in order; interleave threads by time
+  std::stable_sort (batch.begin (),
+                    batch.begin () + static_cast<std::ptrdiff_t> (used),
+                    [] (const Entry &a, const Entry &b) {
+                      return a.time < b.time;
+                    });
+  for (size_t i = 0; i < used; ++i)
+    {
+      Entry &entry = batch[i];
+      if (!entry.record.empty ())
+        {
+          decode (entry.record.data (), entry.record.size (), entry.line);
+        }
+      emit (entry.level, entry.line);
+    }
+  if (used > 0)
+    {
+      std::fflush (stdout);
+    }
+  return used > 0;
+}
+
+void
+Logger::run ()
+{
+  constexpr auto INTERVAL = std::chrono::milliseconds (2);
+  uint64_t served = 0;
+  while (running_.load (std::memory_order_acquire))
+    {
+      {
+        std::unique_lock<std::mutex> lock (wake_mutex_);
+        wake_.wait_for (lock, INTERVAL, [&] {
+          return flush_requested_ != served || !running_.load ();
+        });
+        served = flush_requested_;
+      }
+
+      drain ();
+
+      std::lock_guard<std::mutex> lock (wake_mutex_);
+      flush_done_ = served;
+      drained_.notify_all ();
+    }
+
+  std::lock_guard<std::mutex> lock (wake_mutex_);
+  flush_done_ = flush_requested_;
+  drained_.notify_all ();
+}
+
+void
+log_lines (LogLevel level, const std::string &text)
+{
+  if (text.empty ())
+    {
+      return;
+    }
+  // The logger ends every message with a newline
+  Logger::instance ().write (
+      level, std::string_view (text).substr (0, text.size () - 1));
+}
+
+} // namespace jettison
@@ -0,0 +1,343 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 Jettison Project Team
+
+#ifndef LOGGER_H
+#define LOGGER_H
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace jettison
+{
+
+/**
+ * @brief Message severity; Warning and Error go to stderr by default
+ */
+enum class LogLevel : uint8_t
+{
+  Debug,
+  Info,
+  Warning,
+  Error
+};
+
+/**
+ * @brief Parse a level name
+ * @param name "debug", "info", "warning" or "error"
+ * @return Level, or std::nullopt if unknown
+ */
+std::optional<LogLevel> parse_log_level (const std::string &name);
+
+/**
+ * @brief One argument of a log message, captured without formatting
+ *
+ * Text is referenced, not copied, so it only has to outlive the call.
+ */
+struct LogArg
+{
+  enum class Type : uint8_t
+  {
+    Text = 1, // 0 marks record padding
+    Signed,
+    Unsigned,
+    Real,
+    Deferred
+  };
+
+  /**
+   * @brief Appends the text for a Deferred argument's bytes to line
+   */
+  using Formatter = void (*) (std::string_view bytes, std::string &line);
+
+  /**
+   * @brief Capture bytes to be formatted when the record is written
+   *
+   * The bytes are copied into the record like text. formatter runs on
+   * the logger's thread (on the caller's while the logger is stopped),
+   * so an expensive conversion, e.g. a message to JSON, costs the caller
+   * only the copy.
+   *
+   * @param bytes Raw argument
+   * @param formatter Thread-safe function formatting bytes
+   * @return Argument
+   */
+  static LogArg
+  deferred (std::string_view bytes, Formatter formatter)
+  {
+    LogArg arg;
+    arg.type = Type::Deferred;
+    arg.text = bytes;
+    arg.formatter = formatter;
+    return arg;
+  }
+
+  template <typename T> LogArg (const T &value)
+  {
+    if constexpr (std::is_convertible_v<const T &, std::string_view>)
+      {
+        type = Type::Text;
+        text = value;
+      }
+    else if constexpr (std::is_same_v<T, char>)
+      {
+        type = Type::Text;
+        text = std::string_view (&value, 1);
+      }
+    else if constexpr (std::is_enum_v<T>)
+      {
+        type = Type::Signed;
+        integer = static_cast<int64_t> (value);
+      }
+    else if constexpr (std::is_floating_point_v<T>)
+      {
+        type = Type::Real;
+        real = static_cast<double> (value);
+      }
+    else if constexpr (std::is_signed_v<T>)
+      {
+        type = Type::Signed;
+        integer = value;
+      }
+    else
+      {
+        static_assert (std::is_unsigned_v<T>,
+                       "log arguments are text, numbers or enums");
+        type = Type::Unsigned;
+        unsigned_integer = value;
+      }
+  }
+
+  Type type;
+  std::string_view text;
+  union
+  {
+    int64_t integer;
+    uint64_t unsigned_integer;
+    double real;
+    Formatter formatter;
+  };
+
+private:
+  LogArg () = default;
+};
+
+/**
+ * @brief Logger counters
+ */
+struct LogStats
+{
+  uint64_t written = 0; // Records delivered to the sink
+  uint64_t dropped = 0;   // Records dropped, including oversized ones
+  uint64_t oversized = 0; // ...because they exceeded max_record_bytes()
+};
+
+/**
+ * @brief Asynchronous logger with per-thread lock-free buffers
+ *
+ * While started, a message is encoded as one binary record (timestamp,
+ * level, then each argument as raw bytes or text) into a single-producer
+ * ring owned by the calling thread: no lock, allocation, formatting or
+ * system call on the caller's side. A background thread drains every
+ * ring every few milliseconds, formats the records (numbers as decimal,
+ * reals with 12 significant digits), orders each batch by timestamp and
+ * hands one line per record to the sink. When a ring is full the record
+ * is dropped and counted, so a slow terminal can never stall the event
+ * loop or a worker. A record larger than a quarter of the ring is
+ * dropped too; the logger thread reports those with a warning, since
+ * they are a message that can never be written rather than a transient
+ * overload.
+ *
+ * Arguments built with LogArg::deferred() are formatted on the logger
+ * thread as well, so a frame report passes the payload and only the
+ * logger converts it to JSON.
+ *
+ * While stopped (before start() and after stop()) messages are formatted
+ * and written synchronously, so the same calls work in one-shot modes.
+ * A newline is appended to every message.
+ */
+class Logger
+{
+public:
+  using Sink = std::function<void (LogLevel level, std::string_view line)>;
+
+  static constexpr size_t DEFAULT_BUFFER_BYTES = size_t{ 1 } << 20;
+
+  /**
+   * @brief Get the process-wide logger
+   * @return Logger
+   */
+  static Logger &instance ();
+
+  /**
+   * @brief Stop the background thread, writing what is buffered
+   */
+  ~Logger ();
+
+  // Non-copyable, non-movable
+  Logger (const Logger &) = delete;
+  Logger &operator= (const Logger &) = delete;
+  Logger (Logger &&) = delete;
+  Logger &operator= (Logger &&) = delete;
+
+  /**
+   * @brief Start the background thread
+   * @param buffer_bytes Ring size per logging thread (rounded up to a
+   *                     power of two; a record may use a quarter of it)
+   */
+  void start (size_t buffer_bytes = DEFAULT_BUFFER_BYTES);
+
+  /**
+   * @brief Write everything buffered and stop the background thread
+   */
+  void stop ();
+
+  /**
+   * @brief Wait until every record logged so far has reached the sink
+   */
+  void flush ();
+
+  /**
+   * @brief Set the lowest level written (default Info)
+   * @param level Minimum level
+   */
+  void set_level (LogLevel level);
+
+  /**
+   * @brief Check whether a level is written
+   * @param level Level
+   * @return true if messages at level are not filtered out
+   */
+  bool
+  enabled (LogLevel level) const
+  {
+    return level >= level_.load (std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Get the largest record a thread's ring accepts while started
+   * @return Size in bytes, header and arguments included
+   */
+  size_t max_record_bytes () const { return buffer_bytes_ / 4; }
+
+  /**
+   * @brief Replace the default stdout/stderr sink (only while stopped)
+   * @param sink Function called with each formatted line
+   */
+  void set_sink (Sink sink);
+
+  /**
+   * @brief Get the counters
+   * @return Statistics
+   */
+  LogStats stats () const;
+
+  /**
+   * @brief Log a message made of the concatenated arguments
+   * @param level Severity
+   * @param args Text, numbers or enums
+   */
+  template <typename... Args>
+  void
+  write (LogLevel level, const Args &...args)
+  {
+    if (enabled (level))
+      {
+        const std::array<LogArg, sizeof...(Args)> list{ LogArg (args)... };
+        write_args (level, list.data (), list.size ());
+      }
+  }
+
+private:
+  struct Buffer;
+
+  Logger ();
+
+  void write_args (LogLevel level, const LogArg *args, size_t count);
+  Buffer *thread_buffer ();
+  void run ();
+  bool drain ();
+  void emit (LogLevel level, std::string_view line);
+
+  std::atomic<LogLevel> level_{ LogLevel::Info };
+  std::atomic<bool> running_{ false };
+  size_t buffer_bytes_ = DEFAULT_BUFFER_BYTES;
+  Sink sink_;
+
+  mutable std::mutex buffers_mutex_; // Thread registration and draining
+  std::vector<std::unique_ptr<Buffer>> buffers_;
+  uint64_t retired_dropped_ = 0;   // Drops of buffers already released
+  uint64_t retired_oversized_ = 0; // ...of which oversized
+  std::atomic<uint64_t> written_{ 0 };
+
+  std::mutex wake_mutex_;
+  std::condition_variable wake_;
+  std::condition_variable drained_;
+  uint64_t flush_requested_ = 0;
+  uint64_t flush_done_ = 0;
+  std::thread thread_;
+
+  std::mutex sync_mutex_; // Synchronous writes while stopped
+};
+
+/**
+ * @brief Log at Debug level
+ */
+template <typename... Args>
+void
+log_debug (const Args &...args)
+{
+  Logger::instance ().write (LogLevel::Debug, args...);
+}
+
+/**
+ * @brief Log at Info level
+ */
+template <typename... Args>
+void
+log_info (const Args &...args)
+{
+  Logger::instance ().write (LogLevel::Info, args...);
+}
+
+/**
+ * @brief Log at Warning level
+ */
+template <typename... Args>
+void
+log_warning (const Args &...args)
+{
+  Logger::instance ().write (LogLevel::Warning, args...);
+}
+
+/**
+ * @brief Log at Error level
+ */
+template <typename... Args>
+void
+log_error (const Args &...args)
+{
+  Logger::instance ().write (LogLevel::Error, args...);
+}
+
+/**
+ * @brief Log a block of lines as one message, e.g. a frame report
+ * @param level Severity
+ * @param text Lines, each ending with a newline
+ */
+void log_lines (LogLevel level, const std::string &text);
+
+} // namespace jettison
+
+#endif // LOGGER_H
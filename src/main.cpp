@@ -1,29 +1,50 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 // Copyright (C) 2025 Jettison Project Team
 
+#include "cli_options.h"
+#include "columnar_writer.h"
+#include "dedup_store.h"
 #include "dump_manager.h"
+#include "history_store.h"
 #include "json_converter.h"
+#include "logger.h"
 #include "proto_validator.h"
-#include "websocket_client.h"
+#include "receiver.h"
+#include "shm_state.h"
+#include "state_generator.h"
+#include "stream_session.h"
+#include "wire_inspector.h"
+#include <algorithm>
+#include <chrono>
 #include <csignal>
+#include <cstdint>
 #include <cstdlib>
+#include <iomanip>
 #include <iostream>
+#include <map>
 #include <memory>
+#include <sstream>
 #include <string>
 #include <atomic>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include <poll.h>
+#include <unistd.h>
 
 using namespace jettison;
 
 static std::atomic<bool> g_running{ true };
-static WebSocketClient *g_client = nullptr;
+static StreamSession *g_session = nullptr;
 
 static void
 signal_handler (int /*signal*/)
 {
   g_running = false;
-  if (g_client != nullptr)
+  if (g_session != nullptr)
     {
-      g_client->disconnect ();
+      g_session->stop ();
     }
 }
 
@@ -37,148 +58,265 @@ print_help (const char *program_name)
             << "Connect and stream state from host\n";
   std::cout << "  " << program_name << " <host> --dump N    "
             << "Dump N payloads to dumps/ directory\n";
+  std::cout << "  " << program_name << " <host> --rate HZ   "
+            << "Validate every frame, print at most HZ frames/s\n";
+  std::cout << "  " << program_name << " --hosts a,b,c      "
+            << "Stream state from several hosts at once\n";
+  std::cout << "  " << program_name
+            << " --read-dump <file>  Read, validate and print dump file\n";
+  std::cout << "  " << program_name
+            << " --read-shm <name>   Print the latest state published by --shm\n";
+  std::cout << "  " << program_name
+            << " --convert-dumps <out> <dump>...  Dumps to columns/CSV\n";
+  std::cout << "  " << program_name
+            << " --inspect-dump <dump>...  Walk wire format, locate corruption\n";
   std::cout << "  " << program_name
-            << " --read-dump <file>  Read, validate and print dump file\n\n";
+            << " --diff-dump <a> <b>  Show where two dumps first differ\n";
+  std::cout << "  " << program_name
+            << " --pack-dumps <out.jdd> <dump>...  Dumps to a dump store\n";
+  std::cout << "  " << program_name
+            << " --replay [<dump>...]  Parse/validate/JSON throughput\n\n";
   std::cout << "Arguments:\n";
-  std::cout << "  <host>         Hostname or IP address (e.g., sych.local)\n";
-  std::cout << "  --dump N       Dump N payloads and exit\n";
+  std::cout << "  <host>         Hostname or IP address (e.g., sych.local),\n"
+               "                 host:port, or ws://host:port/path\n";
+  std::cout << "  --dump N       Dump N payloads and exit (single host only)\n";
+  std::cout << "  --rate HZ      Print valid frames at most HZ times per second\n";
+  std::cout << "  --every K      Print only every Kth valid frame\n";
+  std::cout << "  --hosts LIST   Comma-separated list of hosts\n";
+  std::cout << "  --hosts-file F File with one host per line (# comments)\n";
+  std::cout << "  --workers N    Validate on N worker threads\n";
+  std::cout << "  --no-reconnect Exit when the connection closes\n";
+  std::cout << "  --reconnect-max MS  Cap reconnect backoff (default 30000)\n";
+  std::cout << "  --deflate      Negotiate permessage-deflate compression\n";
+  std::cout << "  --deflate-window-bits N  Limit server window (8-15)\n";
+  std::cout << "  --deflate-no-context-takeover  Reset window per message\n";
+  std::cout << "  --anomalies    Warn on jumps, spikes and stuck values\n";
+  std::cout << "  --skip-duplicates  Drop repeated frames before parsing\n";
+  std::cout << "  --realtime     Lock and pre-fault memory, pin threads "
+               "(with --cpus)\n";
+  std::cout << "  --cpus LIST    CPUs for event loop then workers, e.g. "
+               "2,3 or 2-5\n";
+  std::cout << "  --rt-priority N  Run processing threads SCHED_FIFO at N "
+               "(1-99)\n";
+  std::cout << "  --violation-window S  Summarize repeated violations every S "
+               "s\n"
+               "                 (default 10, 0 = print every invalid frame)\n";
+  std::cout << "  --shm NAME     Publish latest valid state to shared memory\n";
+  std::cout << "  --record FILE  Record numeric fields as columns "
+               "(.csv for CSV)\n";
+  std::cout << "  --capture FILE Record every raw payload to a deduplicating "
+               "dump store\n";
+  std::cout << "  --ndjson FILE  Stream every parsed frame as one JSON line "
+               "(file or FIFO)\n";
+  std::cout << "  --sink-queue SINK=N[:POLICY]  Queue of an output (dump, "
+               "capture, ndjson,\n"
+               "                 shm, record): N frames, drop-newest, "
+               "drop-oldest or block\n";
+  std::cout << "  --history F,G  Keep 1 min raw / 1 h of 1 s / 1 day of 1 min "
+               "history\n"
+               "                 of fields ('default' for a standard set), "
+               "query on stdin\n";
+  std::cout << "  --watch PATH[:DEADBAND[:PERIOD]]  Print only changes of a "
+               "field\n"
+               "                 (repeatable, e.g. compass.azimuth:0.5:360)\n";
+  std::cout << "  --compare PATH[:TOLERANCE[:PERIOD]]  Print only where hosts "
+               "disagree\n"
+               "                 on a field (repeatable, 'default' for a "
+               "standard set)\n";
+  std::cout << "  --align-by PATH  Field aligning --compare frames "
+               "(default\n"
+               "                 actual_space_time.timestamp)\n";
+  std::cout << "  --log-level L  Lowest level printed: debug, info (default), "
+               "warning,\n"
+               "                 error\n";
   std::cout << "  --read-dump    Read and validate a dump file\n\n";
   std::cout << "Examples:\n";
   std::cout << "  " << program_name << " sych.local\n";
   std::cout << "  " << program_name << " sych.local --dump 10\n";
-  std::cout << "  " << program_name << " --read-dump dumps/state_0001.bin\n\n";
+  std::cout << "  " << program_name << " sych.local --rate 5\n";
+  std::cout << "  " << program_name
+            << " --hosts-file fleet.txt --workers 4 --rate 1\n";
+  std::cout << "  " << program_name << " --read-dump dumps/state_0001.bin\n";
+  std::cout << "  " << program_name << " --inspect-dump dumps/*.bin\n";
+  std::cout << "  " << program_name << " sych.local --shm /jettison_state\n";
+  std::cout << "  " << program_name
+            << " sych.local --dump 100 --ndjson state.fifo --record run.jcol\n";
+  std::cout << "  " << program_name
+            << " sych.local --watch compass.azimuth:0.5:360 "
+               "--watch rec_osd.recording\n\n";
   std::cout << "Notes:\n";
   std::cout << "  - SSL certificate errors are ignored for local connections\n";
   std::cout << "  - Dumps may contain sensitive data - handle with care\n";
+  std::cout << "  - Frame N of a dump store is read as store.jdd#N; dump "
+               "lists may name\n"
+               "    whole stores\n";
+  std::cout << "  - Frames failing validation are always printed, regardless "
+               "of --rate/--every\n";
+  std::cout << "  - With several hosts, output lines are prefixed with "
+               "[host:port]\n";
+  std::cout << "  - Lost connections are retried with jittered exponential "
+               "backoff\n";
   std::cout << "  - Press Ctrl+C to stop streaming\n";
 }
 
-static int
-stream_mode (const std::string &host, int dump_count)
+static int64_t
+unix_time_ns ()
 {
-  const int port = 443;
-  const std::string path = "/ws/ws_state";
+  return std::chrono::duration_cast<std::chrono::nanoseconds> (
+             std::chrono::system_clock::now ().time_since_epoch ())
+      .count ();
+}
 
-  std::cout << "Connecting to wss://" << host << ":" << port << path << "\n";
+/**
+ * @brief Answer one history command read from stdin
+ *
+ * Commands: "fields", "query FIELD raw|1s|1m SECONDS [HOST]".
+ */
+static void
+handle_history_command (
+    const std::string &command,
+    const std::vector<std::unique_ptr<HistoryStore>> &stores)
+{
+  std::istringstream words (command);
+  std::string verb;
+  if (!(words >> verb))
+    {
+      return;
+    }
 
-  WebSocketClient client (host, port, path);
-  g_client = &client;
+  std::ostringstream out;
+  out.precision (12);
+  if (verb == "fields")
+    {
+      for (const auto &field : stores[0]->fields ())
+        {
+          out << field.path () << "\n";
+        }
+    }
+  else if (verb == "query")
+    {
+      std::string path;
+      std::string resolution_name;
+      double seconds = 0.0;
+      size_t host = 0;
+      words >> path >> resolution_name >> seconds;
+      if (!(words >> host))
+        {
+          host = 0;
+        }
 
-  ProtoValidator validator;
-  JsonConverter json_converter;
-  DumpManager dump_manager;
+      const auto resolution = HistoryStore::parse_resolution (resolution_name);
+      const auto field = host < stores.size ()
+                             ? stores[host]->field_index (path)
+                             : std::nullopt;
+      if (!resolution || !field || seconds <= 0.0)
+        {
+          out << "Error: usage: query FIELD raw|1s|1m SECONDS [HOST]\n";
+        }
+      else
+        {
+          const int64_t now = unix_time_ns ();
+          const auto points = stores[host]->query (
+              *field, *resolution, now - static_cast<int64_t> (seconds * 1e9),
+              now);
+          for (const auto &point : points)
+            {
+              out << point.time_ns / 1000000000 << "." << std::setw (3)
+                  << std::setfill ('0') << (point.time_ns / 1000000) % 1000
+                  << std::setfill (' ') << " min=" << point.min << " max=" << point.max
+                  << " mean=" << point.mean << " n=" << point.count << "\n";
+            }
+          out << points.size () << " points\n";
+        }
+    }
+  else
+    {
+      out << "Commands: fields | query FIELD raw|1s|1m SECONDS [HOST]\n";
+    }
 
-  int message_count = 0;
-  int saved_count = 0;
-
-  // Setup callbacks
-  client.set_connection_callback ([&] (bool connected) {
-    if (connected)
-      {
-        std::cout << "Connected successfully\n";
-      }
-    else
-      {
-        std::cout << "Disconnected\n";
-        g_running = false;
-      }
-  });
-
-  client.set_error_callback (
-      [&] (const std::string &error) { std::cerr << "Error: " << error << "\n"; });
-
-  client.set_message_callback ([&] (const uint8_t *data, size_t len) {
-    message_count++;
-    std::cout << "\n=== Message #" << message_count << " (size: " << len
-              << " bytes) ===\n";
-
-    // Save dump if requested
-    if (dump_count > 0 && saved_count < dump_count)
-      {
-        dump_manager.ensure_dump_dir_exists ();
-        if (dump_manager.save_dump (data, len, saved_count + 1))
-          {
-            saved_count++;
-            std::cout << "Saved dump " << saved_count << "/" << dump_count
-                      << "\n";
-
-            if (saved_count >= dump_count)
-              {
-                std::cout << "Dump complete. Exiting.\n";
-                g_running = false;
-                client.disconnect ();
-                return;
-              }
-          }
-        else
-          {
-            std::cerr << "Failed to save dump\n";
-          }
-      }
-
-    // Parse and validate
-    auto state_opt = validator.parse_and_validate (data, len);
-    const auto &result = validator.get_last_result ();
-
-    if (!state_opt)
-      {
-        std::cerr << "INVALID MESSAGE\n";
-        std::cerr << "Parse errors:\n";
-        for (const auto &error : result.errors)
-          {
-            std::cerr << "  - " << error << "\n";
-          }
-        return;
-      }
-
-    // Print validation status
-    if (result.is_valid)
-      {
-        std::cout << "Validation: PASSED\n";
-      }
-    else
-      {
-        std::cout << "Validation: FAILED\n";
-        for (const auto &error : result.errors)
-          {
-            std::cout << "  Error: " << error << "\n";
-          }
-      }
-
-    if (!result.warnings.empty ())
-      {
-        std::cout << "Warnings:\n";
-        for (const auto &warning : result.warnings)
-          {
-            std::cout << "  - " << warning << "\n";
-          }
-      }
-
-    // Convert to JSON
-    if (dump_count == 0) // Only print JSON in non-dump mode
-      {
-        std::string json = json_converter.to_json (*state_opt, true);
-        std::cout << "\nJSON Output:\n" << json << "\n";
-      }
-  });
+  log_lines (LogLevel::Info, out.str ());
+}
+
+/**
+ * @brief Read history commands from stdin until streaming stops
+ */
+static void
+history_query_loop (const std::vector<std::unique_ptr<HistoryStore>> &stores)
+{
+  pollfd stdin_poll{ STDIN_FILENO, POLLIN, 0 };
+  std::string pending;
+  char buffer[256];
+
+  while (g_running)
+    {
+      if (poll (&stdin_poll, 1, 200) <= 0)
+        {
+          continue;
+        }
+      const ssize_t n = read (STDIN_FILENO, buffer, sizeof buffer);
+      if (n <= 0)
+        {
+          return;
+        }
+      pending.append (buffer, static_cast<size_t> (n));
+
+      size_t newline;
+      while ((newline = pending.find ('\n')) != std::string::npos)
+        {
+          handle_history_command (pending.substr (0, newline), stores);
+          pending.erase (0, newline + 1);
+        }
+    }
+}
+
+static int
+stream_mode (const StreamOptions &options, LogLevel log_level)
+{
+  // Everything the session logs, from opening it to its summary, goes
+  // through the logger's per-thread buffers
+  Logger &logger = Logger::instance ();
+  logger.set_level (log_level);
+  logger.start ();
+
+  StreamSession session (options);
+  if (!session.open ())
+    {
+      logger.stop ();
+      return EXIT_FAILURE;
+    }
+  if (!session.history ().empty ())
+    {
+      log_info ("Type 'help' for history queries");
+    }
+  g_session = &session;
 
   // Setup signal handlers
   std::signal (SIGINT, signal_handler);
   std::signal (SIGTERM, signal_handler);
 
-  // Connect and run
-  if (!client.connect ())
+  std::thread query_thread;
+  if (!session.history ().empty ())
     {
-      std::cerr << "Failed to initiate connection\n";
-      g_client = nullptr;
-      return EXIT_FAILURE;
+      query_thread
+          = std::thread (history_query_loop, std::cref (session.history ()));
     }
 
-  client.run ();
+  const bool ok = session.run ();
 
-  g_client = nullptr;
-  std::cout << "Total messages received: " << message_count << "\n";
+  g_session = nullptr;
+  g_running = false;
+  if (query_thread.joinable ())
+    {
+      query_thread.join ();
+    }
+  if (!ok)
+    {
+      logger.stop ();
+      return EXIT_FAILURE;
+    }
 
+  session.finish ();
+  logger.stop ();
   return EXIT_SUCCESS;
 }
 
@@ -187,6 +325,8 @@ read_dump_mode (const std::string &filename)
 {
   std::cout << "Reading dump file: " << filename << "\n";
 
+  // Compile validation rules while the file is read
+  ProtoValidator validator (ProtoValidator::create_factory_async ());
   DumpManager dump_manager;
   auto data = dump_manager.read_dump (filename);
 
@@ -198,7 +338,6 @@ read_dump_mode (const std::string &filename)
 
   std::cout << "Read " << data.size () << " bytes\n";
 
-  ProtoValidator validator;
   JsonConverter json_converter;
 
   auto state_opt = validator.parse_and_validate (data.data (), data.size ());
@@ -212,6 +351,10 @@ read_dump_mode (const std::string &filename)
         {
           std::cerr << "  - " << error << "\n";
         }
+      WireScan scan;
+      WireInspector::scan (data.data (), data.size (), scan, false);
+      std::cerr << "Wire format: " << WireInspector::describe_error (scan)
+                << "\n";
       return EXIT_FAILURE;
     }
 
@@ -245,6 +388,446 @@ read_dump_mode (const std::string &filename)
   return EXIT_SUCCESS;
 }
 
+static int
+convert_dumps_mode (const std::string &output,
+                    const std::vector<std::string> &dump_files)
+{
+  ColumnarWriter writer;
+  if (!writer.open (output, ColumnarWriter::format_for (output)))
+    {
+      return EXIT_FAILURE;
+    }
+
+  const auto start = std::chrono::steady_clock::now ();
+  DumpManager dump_manager;
+  ProtoValidator validator (ProtoValidator::create_factory_async ());
+  ser::JonGUIState state;
+  uint64_t frame = 0;
+  uint64_t skipped = 0;
+
+  for (const auto &filename : dump_manager.expand_dumps (dump_files))
+    {
+      frame++;
+      auto data = dump_manager.read_dump (filename);
+      if (data.empty ()
+          || !validator.parse_and_validate (data.data (), data.size (), state))
+        {
+          std::cerr << "Skipping unreadable dump: " << filename << "\n";
+          skipped++;
+          continue;
+        }
+      writer.append (state, frame, 0, validator.get_last_result ().is_valid);
+    }
+
+  if (!writer.close ())
+    {
+      std::cerr << "Error: failed to write " << output << "\n";
+      return EXIT_FAILURE;
+    }
+
+  const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds> (
+      std::chrono::steady_clock::now () - start);
+  std::cout << "Wrote " << writer.rows () << " rows x "
+            << writer.column_count () << " columns to " << output << " in "
+            << elapsed.count () << " ms";
+  if (skipped > 0)
+    {
+      std::cout << " (" << skipped << " dumps skipped)";
+    }
+  std::cout << "\n";
+
+  return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Print every field of a scanned payload, indented by depth
+ */
+static void
+print_wire_fields (const uint8_t *data, const WireScan &scan)
+{
+  static const char *const WIRE_TYPES[] = { "varint", "fixed64", "len", "",
+                                            "",       "fixed32" };
+  for (const auto &field : scan.fields)
+    {
+      const size_t depth = field.path.depth;
+      const std::string name
+          = field.descriptor != nullptr
+                ? field.descriptor->name ()
+                : "#" + std::to_string (field.path.numbers[depth - 1]);
+      std::cout << std::setw (8) << field.offset << "  "
+                << std::string (2 * (depth - 1), ' ') << name
+                << " (" << WIRE_TYPES[field.wire_type] << ") = "
+                << WireInspector::format_value (field, data) << "\n";
+    }
+}
+
+/**
+ * @brief Describe the field holding a byte, for --diff-dump
+ */
+static std::string
+describe_wire_field (const WireField *field, const uint8_t *data)
+{
+  if (field == nullptr)
+    {
+      return "(outside any field)";
+    }
+  std::ostringstream out;
+  out << field->path.to_string () << " at byte " << field->offset << " = "
+      << WireInspector::format_value (*field, data);
+  return out.str ();
+}
+
+static int
+inspect_dumps_mode (const std::vector<std::string> &files)
+{
+  DumpManager dump_manager;
+  WireScan scan;
+  const auto dump_files = dump_manager.expand_dumps (files);
+
+  if (dump_files.size () == 1)
+    {
+      const auto data = dump_manager.read_dump (dump_files[0]);
+      if (data.empty ())
+        {
+          std::cerr << "Failed to read dump file or file is empty\n";
+          return EXIT_FAILURE;
+        }
+      const bool ok = WireInspector::scan (data.data (), data.size (), scan);
+      std::cout << dump_files[0] << ": " << data.size () << " bytes, "
+                << scan.field_count << " fields\n";
+      print_wire_fields (data.data (), scan);
+      std::cout << "Wire format: " << WireInspector::describe_error (scan)
+                << "\n";
+      return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+  // Sweep: one line per dump, then the most common corruption points
+  struct Point
+  {
+    WireError error;
+    uint32_t offset;
+    std::string path;
+    bool operator< (const Point &other) const
+    {
+      return std::tie (error, offset, path)
+             < std::tie (other.error, other.offset, other.path);
+    }
+  };
+  std::map<Point, uint64_t> points;
+  uint64_t corrupted = 0;
+  const auto start = std::chrono::steady_clock::now ();
+
+  for (const auto &filename : dump_files)
+    {
+      const auto data = dump_manager.read_dump (filename);
+      if (data.empty ())
+        {
+          std::cout << filename << ": unreadable or empty\n";
+          corrupted++;
+          continue;
+        }
+      if (WireInspector::scan (data.data (), data.size (), scan, false))
+        {
+          std::cout << filename << ": OK (" << data.size () << " bytes, "
+                    << scan.field_count << " fields)\n";
+          continue;
+        }
+      corrupted++;
+      std::cout << filename << ": " << WireInspector::describe_error (scan)
+                << "\n";
+      points[Point{ scan.error, scan.error_offset,
+                    scan.error_path.to_string () }]++;
+    }
+
+  const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds> (
+      std::chrono::steady_clock::now () - start);
+  std::cout << "Scanned " << dump_files.size () << " dumps in "
+            << elapsed.count () << " ms: " << dump_files.size () - corrupted
+            << " OK, " << corrupted << " corrupted\n";
+
+  if (!points.empty ())
+    {
+      std::vector<std::pair<uint64_t, Point>> ranked;
+      for (const auto &[point, count] : points)
+        {
+          ranked.emplace_back (count, point);
+        }
+      std::stable_sort (ranked.begin (), ranked.end (),
+                        [] (const auto &a, const auto &b) {
+                          return a.first > b.first;
+                        });
+      ranked.resize (std::min<size_t> (ranked.size (), 10));
+      std::cout << "Most common corruption points:\n";
+      for (const auto &[count, point] : ranked)
+        {
+          std::cout << std::setw (8) << count << "  "
+                    << wire_error_name (point.error) << " at byte "
+                    << point.offset << " in " << point.path << "\n";
+        }
+    }
+
+  return corrupted == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+static int
+diff_dumps_mode (const std::string &file_a, const std::string &file_b)
+{
+  DumpManager dump_manager;
+  const auto a = dump_manager.read_dump (file_a);
+  const auto b = dump_manager.read_dump (file_b);
+  if (a.empty () || b.empty ())
+    {
+      std::cerr << "Failed to read " << (a.empty () ? file_a : file_b)
+                << " or file is empty\n";
+      return EXIT_FAILURE;
+    }
+
+  WireScan scan_a;
+  WireScan scan_b;
+  WireInspector::scan (a.data (), a.size (), scan_a);
+  WireInspector::scan (b.data (), b.size (), scan_b);
+  std::cout << "a: " << file_a << " (" << a.size () << " bytes, "
+            << WireInspector::describe_error (scan_a) << ")\n";
+  std::cout << "b: " << file_b << " (" << b.size () << " bytes, "
+            << WireInspector::describe_error (scan_b) << ")\n";
+
+  const WireDiff diff
+      = diff_wire (a.data (), a.size (), scan_a, b.data (), b.size (), scan_b);
+  if (diff.identical)
+    {
+      std::cout << "Identical\n";
+      return EXIT_SUCCESS;
+    }
+
+  std::cout << "First difference at byte " << diff.offset << "\n";
+  std::cout << "  a: " << describe_wire_field (diff.a, a.data ()) << "\n";
+  std::cout << "  b: " << describe_wire_field (diff.b, b.data ()) << "\n";
+
+  // Further differences, while both dumps have the same field layout
+  constexpr size_t MAX_LISTED = 20;
+  size_t listed = 0;
+  size_t differing = 0;
+  const size_t common = std::min (scan_a.fields.size (), scan_b.fields.size ());
+  size_t i = 0;
+  for (; i < common; ++i)
+    {
+      const WireField &fa = scan_a.fields[i];
+      const WireField &fb = scan_b.fields[i];
+      if (!(fa.path == fb.path) || fa.wire_type != fb.wire_type)
+        {
+          break;
+        }
+      const bool leaf = fa.descriptor == nullptr
+                        || fa.descriptor->message_type () == nullptr;
+      if (!leaf
+          || std::equal (a.begin () + fa.value_offset, a.begin () + fa.end,
+                         b.begin () + fb.value_offset, b.begin () + fb.end))
+        {
+          continue;
+        }
+      differing++;
+      if (listed++ < MAX_LISTED)
+        {
+          std::cout << "  " << fa.path.to_string () << ": "
+                    << WireInspector::format_value (fa, a.data ()) << " -> "
+                    << WireInspector::format_value (fb, b.data ()) << "\n";
+        }
+    }
+  std::cout << differing << " fields differ";
+  if (i < scan_a.fields.size () || i < scan_b.fields.size ())
+    {
+      std::cout << " before the layouts diverge at field " << i + 1;
+    }
+  std::cout << "\n";
+
+  return EXIT_FAILURE;
+}
+
+static int
+pack_dumps_mode (const std::string &output,
+                 const std::vector<std::string> &dump_files)
+{
+  DedupWriter writer;
+  if (!writer.open (output))
+    {
+      return EXIT_FAILURE;
+    }
+
+  const auto start = std::chrono::steady_clock::now ();
+  DumpManager dump_manager;
+  uint64_t skipped = 0;
+  for (const auto &filename : dump_manager.expand_dumps (dump_files))
+    {
+      const auto data = dump_manager.read_dump (filename);
+      if (data.empty () || !writer.append (data.data (), data.size ()))
+        {
+          std::cerr << "Skipping unreadable dump: " << filename << "\n";
+          skipped++;
+        }
+    }
+  if (!writer.close ())
+    {
+      std::cerr << "Error: failed to write " << output << "\n";
+      return EXIT_FAILURE;
+    }
+
+  const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds> (
+      std::chrono::steady_clock::now () - start);
+  std::cout << "Packed " << writer.frames () << " frames into " << output
+            << " in " << elapsed.count () << " ms: "
+            << describe_store_size (writer);
+  if (skipped > 0)
+    {
+      std::cout << " (" << skipped << " dumps skipped)";
+    }
+  std::cout << "\n";
+  return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Replay payloads through parse, validate and JSON at full speed
+ *
+ * The training workload of -DJETTISON_RX_PGO=GENERATE builds, and a
+ * throughput benchmark for comparing builds. Runs whole passes over the
+ * corpus for at least two seconds. Without dumps, generated frames with
+ * a few percent of each corruption kind are replayed instead.
+ */
+static int
+replay_mode (const std::vector<std::string> &dump_files)
+{
+  using Clock = std::chrono::steady_clock;
+  constexpr auto MIN_DURATION = std::chrono::seconds (2);
+  constexpr size_t SYNTHETIC_FRAMES = 4096;
+
+  std::vector<std::vector<uint8_t>> corpus;
+  if (dump_files.empty ())
+    {
+      StateGenerator::Mix mix;
+      mix.out_of_range = 0.05;
+      mix.missing = 0.01;
+      mix.truncated = 0.01;
+      mix.bad_tag = 0.01;
+      StateGenerator generator (mix, 1);
+      corpus.resize (SYNTHETIC_FRAMES);
+      for (auto &payload : corpus)
+        {
+          generator.next (payload);
+        }
+      std::cout << "Replaying " << corpus.size () << " generated frames\n";
+    }
+  else
+    {
+      DumpManager dump_manager;
+      for (const auto &filename : dump_manager.expand_dumps (dump_files))
+        {
+          auto data = dump_manager.read_dump (filename);
+          if (!data.empty ())
+            {
+              corpus.push_back (std::move (data));
+            }
+        }
+      if (corpus.empty ())
+        {
+          std::cerr << "Error: no readable dumps to replay\n";
+          return EXIT_FAILURE;
+        }
+      std::cout << "Replaying " << corpus.size () << " dumps\n";
+    }
+
+  ProtoValidator validator (ProtoValidator::create_factory ());
+  JsonConverter json_converter;
+  ser::JonGUIState state;
+  uint64_t frames = 0;
+  uint64_t valid = 0;
+  uint64_t unparsable = 0;
+  uint64_t json_bytes = 0;
+  Clock::duration validate_time{};
+  Clock::duration json_time{};
+  uint64_t passes = 0;
+
+  const auto start = Clock::now ();
+  while (passes == 0 || Clock::now () - start < MIN_DURATION)
+    {
+      for (const auto &payload : corpus)
+        {
+          const auto t0 = Clock::now ();
+          const bool parsed = validator.parse_and_validate (
+              payload.data (), payload.size (), state);
+          const auto t1 = Clock::now ();
+          validate_time += t1 - t0;
+          frames++;
+          if (!parsed)
+            {
+              unparsable++;
+              continue;
+            }
+          if (validator.get_last_result ().is_valid)
+            {
+              valid++;
+            }
+          json_bytes += json_converter.to_json (state, true).size ();
+          json_time += Clock::now () - t1;
+        }
+      passes++;
+    }
+  const std::chrono::duration<double> elapsed = Clock::now () - start;
+
+  const auto per_frame = [] (Clock::duration total, uint64_t count) {
+    return count > 0 ? static_cast<double> (
+                           std::chrono::duration_cast<std::chrono::nanoseconds> (
+                               total)
+                               .count ())
+                           / static_cast<double> (count)
+                     : 0.0;
+  };
+  std::ostringstream line;
+  line.setf (std::ios::fixed);
+  line.precision (0);
+  line << "Replayed " << frames << " frames (" << passes << " passes) in ";
+  line.precision (2);
+  line << elapsed.count () << " s: ";
+  line.precision (0);
+  line << static_cast<double> (frames) / elapsed.count () << " frames/s\n"
+       << "  parse+validate " << per_frame (validate_time, frames)
+       << " ns/frame, JSON " << per_frame (json_time, frames - unparsable)
+       << " ns/frame (" << valid << " valid, " << frames - valid - unparsable
+       << " invalid, " << unparsable << " unparsable, " << json_bytes / frames
+       << " JSON bytes/frame)\n";
+  std::cout << line.str ();
+  return EXIT_SUCCESS;
+}
+
+static int
+read_shm_mode (const std::string &name)
+{
+  ShmReader reader (name);
+  if (!reader.is_open ())
+    {
+      return EXIT_FAILURE;
+    }
+
+  ser::JonGUIState state;
+  ShmSnapshot snapshot;
+  if (!reader.read_state (state, snapshot))
+    {
+      std::cerr << "No consistent state published in " << name << "\n";
+      return EXIT_FAILURE;
+    }
+
+  const auto age = std::chrono::duration_cast<std::chrono::microseconds> (
+      std::chrono::steady_clock::now () - snapshot.published_at);
+  std::cout << "Shared memory: " << name << "\n";
+  std::cout << "Message #" << snapshot.sequence << " (size: "
+            << snapshot.payload.size () << " bytes, age: " << age.count ()
+            << " us)\n";
+
+  JsonConverter json_converter;
+  std::string json = json_converter.to_json (state, true);
+  std::cout << "\nJSON Output:\n" << json << "\n";
+
+  return EXIT_SUCCESS;
+}
+
 int
 main (int argc, char *argv[])
 {
@@ -275,37 +858,90 @@ main (int argc, char *argv[])
       return read_dump_mode (argv[2]);
     }
 
-  // Stream mode (with optional --dump)
-  std::string host = arg1;
-  int dump_count = 0;
+  // Convert dumps to a column table
+  if (arg1 == "--convert-dumps")
+    {
+      if (argc < 4)
+        {
+          std::cerr << "Error: --convert-dumps requires an output file and "
+                       "at least one dump\n\n";
+          print_help (argv[0]);
+          return EXIT_FAILURE;
+        }
+      return convert_dumps_mode (argv[2],
+                                 std::vector<std::string> (argv + 3,
+                                                           argv + argc));
+    }
 
-  if (argc >= 4)
+  // Wire-level dump inspection
+  if (arg1 == "--inspect-dump")
     {
-      std::string arg2 = argv[2];
-      if (arg2 == "--dump")
+      if (argc < 3)
         {
-          try
-            {
-              dump_count = std::stoi (argv[3]);
-              if (dump_count <= 0)
-                {
-                  std::cerr << "Error: dump count must be positive\n";
-                  return EXIT_FAILURE;
-                }
-            }
-          catch (...)
-            {
-              std::cerr << "Error: invalid dump count\n";
-              return EXIT_FAILURE;
-            }
+          std::cerr << "Error: --inspect-dump requires at least one dump\n\n";
+          print_help (argv[0]);
+          return EXIT_FAILURE;
         }
-      else
+      return inspect_dumps_mode (
+          std::vector<std::string> (argv + 2, argv + argc));
+    }
+
+  if (arg1 == "--diff-dump")
+    {
+      if (argc != 4)
+        {
+          std::cerr << "Error: --diff-dump requires two dumps\n\n";
+          print_help (argv[0]);
+          return EXIT_FAILURE;
+        }
+      return diff_dumps_mode (argv[2], argv[3]);
+    }
+
+  if (arg1 == "--pack-dumps")
+    {
+      if (argc < 4)
+        {
+          std::cerr << "Error: --pack-dumps requires an output file and at "
+                       "least one dump\n\n";
+          print_help (argv[0]);
+          return EXIT_FAILURE;
+        }
+      return pack_dumps_mode (argv[2],
+                              std::vector<std::string> (argv + 3, argv + argc));
+    }
+
+  // Parse/validate/JSON throughput, and the PGO training workload
+  if (arg1 == "--replay")
+    {
+      return replay_mode (std::vector<std::string> (argv + 2, argv + argc));
+    }
+
+  // Read shared memory mode
+  if (arg1 == "--read-shm")
+    {
+      if (argc < 3)
         {
-          std::cerr << "Error: unknown argument '" << arg2 << "'\n\n";
+          std::cerr << "Error: --read-shm requires a region name\n\n";
           print_help (argv[0]);
           return EXIT_FAILURE;
         }
+      const std::string name = argv[2];
+      return read_shm_mode (name.rfind ('/', 0) == 0 ? name : "/" + name);
+    }
+
+  // Stream mode: <host> and/or --hosts/--hosts-file, plus options
+  CliOptions options;
+  switch (parse_stream_options (argc, argv, options))
+    {
+    case CliParseResult::Ok:
+      break;
+    case CliParseResult::Usage:
+      print_help (argv[0]);
+      return EXIT_FAILURE;
+    case CliParseResult::Invalid:
+    default:
+      return EXIT_FAILURE;
     }
 
-  return stream_mode (host, dump_count);
+  return stream_mode (options.stream, options.log_level);
 }
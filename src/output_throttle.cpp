@@ -0,0 +1,52 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 Jettison Project Team
+
+#include "output_throttle.h"
+#include <algorithm>
+
+namespace jettison
+{
+
+OutputThrottle::OutputThrottle (double max_hz, uint32_t every_k)
+    : min_interval_ (Clock::duration::zero ()), every_k_ (every_k),
+      frames_seen_ (0), suppressed_ (0), has_emitted_ (false)
+{
+  // The floor keeps the interval within the clock's range
+  if (max_hz > 0.0)
+    {
+      min_interval_ = std::chrono::duration_cast<Clock::duration> (
+          std::chrono::duration<double> (1.0 / std::max (max_hz, MIN_HZ)));
+    }
+}
+
+bool
+OutputThrottle::should_emit (Clock::time_point now)
+{
+  const uint64_t index = frames_seen_++;
+
+  // Every Kth frame (the first frame is always a candidate)
+  if (every_k_ > 1 && index % every_k_ != 0)
+    {
+      suppressed_++;
+      return false;
+    }
+
+  // At most max_hz frames per second
+  if (has_emitted_ && now - last_emit_ < min_interval_)
+    {
+      suppressed_++;
+      return false;
+    }
+
+  has_emitted_ = true;
+  last_emit_ = now;
+  return true;
+}
+
+bool
+OutputThrottle::is_active () const
+{
+  return every_k_ > 1 || min_interval_ > Clock::duration::zero ();
+}
+
+} // namespace jettison
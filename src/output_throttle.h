@@ -0,0 +1,65 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 Jettison Project Team
+
+#ifndef OUTPUT_THROTTLE_H
+#define OUTPUT_THROTTLE_H
+
+#include <chrono>
+#include <cstdint>
+
+namespace jettison
+{
+
+/**
+ * @brief Decides which validated frames get printed
+ *
+ * Every frame is still parsed and validated; the throttle only gates
+ * the (expensive) JSON report for frames that passed validation. Frames
+ * that fail validation bypass the throttle and are always reported.
+ */
+class OutputThrottle
+{
+public:
+  using Clock = std::chrono::steady_clock;
+
+  static constexpr double MIN_HZ = 0.001; // One frame per 1000 s
+
+  /**
+   * @brief Construct an output throttle
+   * @param max_hz Emit at most this many frames per second (0 or NaN =
+   *               unlimited, positive values below MIN_HZ count as MIN_HZ)
+   * @param every_k Emit only every Kth frame (0 or 1 = every frame)
+   */
+  explicit OutputThrottle (double max_hz = 0.0, uint32_t every_k = 0);
+
+  /**
+   * @brief Decide whether the current frame should be emitted
+   * @param now Arrival time of the frame
+   * @return true if the frame should be printed
+   */
+  bool should_emit (Clock::time_point now);
+
+  /**
+   * @brief Check whether any rate control is configured
+   * @return true if some frames may be suppressed
+   */
+  bool is_active () const;
+
+  /**
+   * @brief Get the number of frames suppressed so far
+   * @return Suppressed frame count
+   */
+  uint64_t suppressed_count () const { return suppressed_; }
+
+private:
+  Clock::duration min_interval_;
+  uint32_t every_k_;
+  uint64_t frames_seen_;
+  uint64_t suppressed_;
+  bool has_emitted_;
+  Clock::time_point last_emit_;
+};
+
+} // namespace jettison
+
+#endif // OUTPUT_THROTTLE_H
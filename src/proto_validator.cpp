@@ -2,63 +2,254 @@
 // Copyright (C) 2025 Jettison Project Team
 
 #include "proto_validator.h"
+#include "logger.h"
 #include <google/protobuf/descriptor.h>
 #include <google/protobuf/message.h>
-#include <iostream>
+#include <chrono>
+#include <set>
 
 namespace jettison
 {
 
-ProtoValidator::ProtoValidator ()
+ProtoValidator::ProtoValidator () : ProtoValidator (create_factory ()) {}
+
+ProtoValidator::ProtoValidator (FactoryPtr factory)
+    : validator_factory_ (std::move (factory))
+{
+}
+
+ProtoValidator::ProtoValidator (FactoryFuture factory)
+    : pending_factory_ (std::move (factory))
+{
+}
+
+ProtoValidator::FactoryPtr
+ProtoValidator::create_factory ()
 {
   // Initialize the validator factory
   auto factory_or = buf::validate::ValidatorFactory::New ();
   if (!factory_or.ok ())
     {
-      std::cerr << "Failed to create ValidatorFactory: "
-                << factory_or.status ().message () << "\n";
+      log_error ("Failed to create ValidatorFactory: ",
+                 std::string (factory_or.status ().message ()));
       // Continue anyway - we'll fall back to basic validation
+      return nullptr;
     }
-  else
+
+  return FactoryPtr (std::move (*factory_or));
+}
+
+ProtoValidator::FactoryFuture
+ProtoValidator::create_factory_async (double *elapsed_ms)
+{
+  return std::async (std::launch::async,
+                     [elapsed_ms] {
+                       const auto start = std::chrono::steady_clock::now ();
+                       FactoryPtr factory = create_factory ();
+                       warm_up (factory);
+                       if (elapsed_ms != nullptr)
+                         {
+                           *elapsed_ms
+                               = std::chrono::duration<double, std::milli> (
+                                     std::chrono::steady_clock::now ()
+                                     - start)
+                                     .count ();
+                         }
+                       return factory;
+                     })
+      .share ();
+}
+
+void
+ProtoValidator::warm_up (const FactoryPtr &factory)
+{
+  if (!factory)
+    {
+      return;
+    }
+
+  // Every message type reachable from the root, each compiled once
+  std::vector<const google::protobuf::Descriptor *> pending{
+    ser::JonGUIState::descriptor ()
+  };
+  std::set<const google::protobuf::Descriptor *> seen (pending.begin (),
+                                                       pending.end ());
+  while (!pending.empty ())
     {
-      validator_factory_ = std::move (*factory_or);
+      const auto *type = pending.back ();
+      pending.pop_back ();
+
+      const auto status = factory->Add (type);
+      if (!status.ok ())
+        {
+          log_error ("Failed to compile rules for ",
+                     std::string (type->full_name ()), ": ",
+                     std::string (status.message ()));
+        }
+
+      for (int i = 0; i < type->field_count (); ++i)
+        {
+          const auto *nested = type->field (i)->message_type ();
+          if (nested != nullptr && seen.insert (nested).second)
+            {
+              pending.push_back (nested);
+            }
+        }
     }
+
+  // Run the validator once so the first frame finds everything built
+  google::protobuf::Arena arena;
+  auto validator = factory->NewValidator (&arena, false);
+  (void)validator.Validate (ser::JonGUIState::default_instance ());
 }
 
 std::optional<ser::JonGUIState>
 ProtoValidator::parse_and_validate (const uint8_t *data, size_t len)
 {
-  last_result_ = ValidationResult{ false, {}, {} };
-
   ser::JonGUIState state;
 
-  // Parse the protobuf message
-  if (!state.ParseFromArray (data, static_cast<int> (len)))
+  if (!parse_and_validate (data, len, state) || !last_result_.is_valid)
     {
-      last_result_.errors.push_back ("Failed to parse protobuf message");
       return std::nullopt;
     }
 
+  return state;
+}
+
+bool
+ProtoValidator::parse_and_validate (const uint8_t *data, size_t len,
+                                    ser::JonGUIState &state)
+{
+  // Reuse the vectors' capacity; nothing is allocated per valid frame
+  last_result_.is_valid = false;
+  last_result_.errors.clear ();
+  last_result_.warnings.clear ();
+
+  // Parse the protobuf message (ParseFromArray clears the message first)
+  if (!state.ParseFromArray (data, static_cast<int> (len)))
+    {
+      Violation violation;
+      violation.kind = Violation::Kind::Parse;
+      last_result_.errors.push_back (violation);
+      return false;
+    }
+
   // Validate the parsed message
-  last_result_ = validate (state);
+  validate (state, last_result_);
 
-  if (!last_result_.is_valid)
+  return true;
+}
+
+void
+ProtoValidator::check_anomalies (AnomalyDetector &detector,
+                                 const ser::JonGUIState &state,
+                                 int64_t time_ns)
+{
+  if (last_result_.is_valid)
     {
-      return std::nullopt;
+      detector.check (state, time_ns, last_result_.warnings);
     }
+}
 
-  return state;
+/**
+ * @brief Read the scalar a field path points at
+ * @return The value, or NaN for messages, strings and repeated fields
+ */
+static double
+field_value (const google::protobuf::Message &root, const FieldPath &path)
+{
+  using google::protobuf::FieldDescriptor;
+
+  const google::protobuf::Message *message = &root;
+  for (size_t i = 0; i < path.depth; ++i)
+    {
+      const auto *field
+          = message->GetDescriptor ()->FindFieldByNumber (path.numbers[i]);
+      if (field == nullptr || field->is_repeated ())
+        {
+          return Violation::NONE;
+        }
+
+      const auto *reflection = message->GetReflection ();
+      const bool leaf = i + 1 == path.depth;
+      switch (field->cpp_type ())
+        {
+        case FieldDescriptor::CPPTYPE_MESSAGE:
+          if (leaf)
+            {
+              return Violation::NONE;
+            }
+          message = &reflection->GetMessage (*message, field);
+          continue;
+        case FieldDescriptor::CPPTYPE_DOUBLE:
+          return leaf ? reflection->GetDouble (*message, field)
+                      : Violation::NONE;
+        case FieldDescriptor::CPPTYPE_FLOAT:
+          return leaf ? static_cast<double> (
+                            reflection->GetFloat (*message, field))
+                      : Violation::NONE;
+        case FieldDescriptor::CPPTYPE_INT32:
+          return leaf ? reflection->GetInt32 (*message, field)
+                      : Violation::NONE;
+        case FieldDescriptor::CPPTYPE_INT64:
+          return leaf ? static_cast<double> (
+                            reflection->GetInt64 (*message, field))
+                      : Violation::NONE;
+        case FieldDescriptor::CPPTYPE_UINT32:
+          return leaf ? reflection->GetUInt32 (*message, field)
+                      : Violation::NONE;
+        case FieldDescriptor::CPPTYPE_UINT64:
+          return leaf ? static_cast<double> (
+                            reflection->GetUInt64 (*message, field))
+                      : Violation::NONE;
+        case FieldDescriptor::CPPTYPE_ENUM:
+          return leaf ? reflection->GetEnumValue (*message, field)
+                      : Violation::NONE;
+        case FieldDescriptor::CPPTYPE_BOOL:
+          return leaf && reflection->GetBool (*message, field) ? 1.0 : 0.0;
+        default:
+          return Violation::NONE;
+        }
+    }
+  return Violation::NONE;
 }
 
-ValidationResult
-ProtoValidator::validate (const ser::JonGUIState &state)
+/**
+ * @brief Record a missing required sub-message
+ */
+static void
+add_missing (ValidationResult &result, int32_t field_number)
+{
+  Violation violation;
+  violation.kind = Violation::Kind::Missing;
+  violation.field.push (field_number);
+  result.errors.push_back (violation);
+  result.is_valid = false;
+}
+
+void
+ProtoValidator::validate (const ser::JonGUIState &state,
+                          ValidationResult &result)
 {
-  ValidationResult result;
   result.is_valid = true;
 
+  // Pick up a factory built in the background, waiting if necessary
+  if (pending_factory_.valid ())
+    {
+      const auto start = std::chrono::steady_clock::now ();
+      validator_factory_ = pending_factory_.get ();
+      pending_factory_ = FactoryFuture ();
+      factory_wait_ms_ = std::chrono::duration<double, std::milli> (
+                             std::chrono::steady_clock::now () - start)
+                             .count ();
+    }
+
   // If protovalidate is available, use it for full validation
   if (validator_factory_)
     {
+      // The previous frame's validator state is no longer referenced
+      arena_.Reset ();
+
       // Create a validator for this validation
       auto validator = validator_factory_->NewValidator (&arena_, false);
 
@@ -67,144 +258,118 @@ ProtoValidator::validate (const ser::JonGUIState &state)
 
       if (!validation_result.ok ())
         {
-          result.errors.push_back ("Validation error: "
-                                   + std::string (validation_result.status ().message ()));
+          Violation violation;
+          violation.kind = Violation::Kind::Error;
+          const auto status = validation_result.status ().message ();
+          violation.detail.assign (status.data (), status.size ());
+          result.errors.push_back (violation);
           result.is_valid = false;
-          return result;
+          return;
         }
 
-      // Check for violations
+      // Record violations as ids and numbers; text is built on demand
       if (!validation_result->success ())
         {
           result.is_valid = false;
           for (int i = 0; i < validation_result->violations_size (); ++i)
             {
-              const auto &violation = validation_result->violations (i);
-              const auto &proto = violation.proto ();
-              std::string error_msg = "Field '";
-
-              // Build field path from protobuf Violation
+              const auto &proto = validation_result->violations (i).proto ();
+              Violation violation;
+              violation.kind = Violation::Kind::Rule;
               if (proto.has_field ())
                 {
-                  // Convert FieldPath to string
-                  const auto &field_path = proto.field ();
-                  std::string path_str;
-                  for (const auto &element : field_path.elements ())
+                  for (const auto &element : proto.field ().elements ())
                     {
-                      if (!path_str.empty ())
-                        path_str += ".";
-                      path_str += element.field_name ();
+                      violation.field.push (element.field_number ());
                     }
-                  error_msg += path_str;
                 }
-              else
-                {
-                  error_msg += "<root>";
-                }
-
-              error_msg += "': " + proto.message ();
-
-              if (!proto.rule_id ().empty ())
-                {
-                  error_msg += " (rule: " + proto.rule_id () + ")";
-                }
-
-              result.errors.push_back (error_msg);
+              violation.rule = RuleTable::intern (proto.rule_id ());
+              violation.detail = proto.message ();
+              violation.value = field_value (state, violation.field);
+              result.errors.push_back (violation);
             }
         }
 
-      return result;
+      return;
     }
 
   // Fallback: Basic validation if protovalidate is not available
   // Check protocol_version (must be > 0 and <= 2147483647)
   if (state.protocol_version () == 0)
     {
-      result.errors.push_back ("protocol_version must be greater than 0");
+      Violation violation;
+      violation.field.push (ser::JonGUIState::kProtocolVersionFieldNumber);
+      violation.detail = "value must be greater than 0";
+      violation.value = 0.0;
+      result.errors.push_back (violation);
       result.is_valid = false;
     }
 
   // Check required fields
   if (!state.has_system ())
     {
-      result.errors.push_back ("Missing required field: system");
-      result.is_valid = false;
+      add_missing (result, ser::JonGUIState::kSystemFieldNumber);
     }
 
   if (!state.has_meteo_internal ())
     {
-      result.errors.push_back ("Missing required field: meteo_internal");
-      result.is_valid = false;
+      add_missing (result, ser::JonGUIState::kMeteoInternalFieldNumber);
     }
 
   if (!state.has_lrf ())
     {
-      result.errors.push_back ("Missing required field: lrf");
-      result.is_valid = false;
+      add_missing (result, ser::JonGUIState::kLrfFieldNumber);
     }
 
   if (!state.has_time ())
     {
-      result.errors.push_back ("Missing required field: time");
-      result.is_valid = false;
+      add_missing (result, ser::JonGUIState::kTimeFieldNumber);
     }
 
   if (!state.has_gps ())
     {
-      result.errors.push_back ("Missing required field: gps");
-      result.is_valid = false;
+      add_missing (result, ser::JonGUIState::kGpsFieldNumber);
     }
 
   if (!state.has_compass ())
     {
-      result.errors.push_back ("Missing required field: compass");
-      result.is_valid = false;
+      add_missing (result, ser::JonGUIState::kCompassFieldNumber);
     }
 
   if (!state.has_rotary ())
     {
-      result.errors.push_back ("Missing required field: rotary");
-      result.is_valid = false;
+      add_missing (result, ser::JonGUIState::kRotaryFieldNumber);
     }
 
   if (!state.has_camera_day ())
     {
-      result.errors.push_back ("Missing required field: camera_day");
-      result.is_valid = false;
+      add_missing (result, ser::JonGUIState::kCameraDayFieldNumber);
     }
 
   if (!state.has_camera_heat ())
     {
-      result.errors.push_back ("Missing required field: camera_heat");
-      result.is_valid = false;
+      add_missing (result, ser::JonGUIState::kCameraHeatFieldNumber);
     }
 
   if (!state.has_compass_calibration ())
     {
-      result.errors.push_back ("Missing required field: compass_calibration");
-      result.is_valid = false;
+      add_missing (result, ser::JonGUIState::kCompassCalibrationFieldNumber);
     }
 
   if (!state.has_rec_osd ())
     {
-      result.errors.push_back ("Missing required field: rec_osd");
-      result.is_valid = false;
+      add_missing (result, ser::JonGUIState::kRecOsdFieldNumber);
     }
 
   if (!state.has_day_cam_glass_heater ())
     {
-      result.errors.push_back (
-          "Missing required field: day_cam_glass_heater");
-      result.is_valid = false;
+      add_missing (result, ser::JonGUIState::kDayCamGlassHeaterFieldNumber);
     }
 
   if (!state.has_actual_space_time ())
     {
-      result.errors.push_back ("Missing required field: actual_space_time");
-      result.is_valid = false;
+      add_missing (result, ser::JonGUIState::kActualSpaceTimeFieldNumber);
     }
-
-  return result;
 }
 
 } // namespace jettison
@@ -6,25 +6,31 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <future>
 #include <memory>
 #include <optional>
 #include <string>
 #include <vector>
 
+#include "anomaly_detector.h"
 #include "buf/validate/validator.h"
 #include "jon_shared_data.pb.h"
+#include "violation.h"
 
 namespace jettison
 {
 
 /**
  * @brief Validation result for a protobuf message
+ *
+ * Errors and warnings are structured Violation records; stream them (or
+ * call to_string()) to get the text.
  */
 struct ValidationResult
 {
   bool is_valid;
-  std::vector<std::string> errors;
-  std::vector<std::string> warnings;
+  std::vector<Violation> errors;
+  std::vector<Violation> warnings;
 };
 
 /**
@@ -32,12 +38,63 @@ struct ValidationResult
  *
  * Parses binary protobuf messages and validates them according
  * to buf.validate constraints embedded in the proto definitions.
+ *
+ * A ProtoValidator is not thread-safe; use one per thread. The
+ * (expensive) ValidatorFactory can be shared between them, and can be
+ * built on a background thread with create_factory_async() while the
+ * caller does other startup work.
  */
 class ProtoValidator
 {
 public:
+  using FactoryPtr = std::shared_ptr<buf::validate::ValidatorFactory>;
+  using FactoryFuture = std::shared_future<FactoryPtr>;
+
+  /**
+   * @brief Construct a validator with its own ValidatorFactory
+   */
   ProtoValidator ();
 
+  /**
+   * @brief Construct a validator sharing an existing ValidatorFactory
+   * @param factory Factory from create_factory() (nullptr = basic checks)
+   */
+  explicit ProtoValidator (FactoryPtr factory);
+
+  /**
+   * @brief Construct a validator whose factory is still being built
+   *
+   * The first validation waits for the factory if it is not ready yet;
+   * see factory_wait_ms().
+   *
+   * @param factory Future from create_factory_async()
+   */
+  explicit ProtoValidator (FactoryFuture factory);
+
+  /**
+   * @brief Create a ValidatorFactory that can be shared across threads
+   * @return Factory, or nullptr if creation failed
+   */
+  static FactoryPtr create_factory ();
+
+  /**
+   * @brief Create and warm up a ValidatorFactory on a background thread
+   * @param elapsed_ms Receives the time spent, before the future becomes
+   *                   ready (may be nullptr)
+   * @return Future of create_factory() followed by warm_up()
+   */
+  static FactoryFuture create_factory_async (double *elapsed_ms = nullptr);
+
+  /**
+   * @brief Compile the rules of every message type in JonGUIState
+   *
+   * protovalidate compiles a message's CEL rules the first time it sees
+   * the type; doing it up front moves that cost off the first frame.
+   *
+   * @param factory Factory to warm up (nullptr is ignored)
+   */
+  static void warm_up (const FactoryPtr &factory);
+
   /**
    * @brief Parse and validate a binary protobuf message
    * @param data Pointer to binary data
@@ -47,22 +104,60 @@ public:
   std::optional<ser::JonGUIState>
   parse_and_validate (const uint8_t *data, size_t len);
 
+  /**
+   * @brief Parse and validate a binary protobuf message in place
+   *
+   * Unlike the optional-returning overload, the parsed message is kept
+   * even when validation fails, and the caller's message (and its
+   * sub-message allocations) can be reused across frames.
+   *
+   * @param data Pointer to binary data
+   * @param len Length of data in bytes
+   * @param state Message to parse into (cleared first)
+   * @return true if the message was parsed; check get_last_result() for
+   *         the validation outcome
+   */
+  bool parse_and_validate (const uint8_t *data, size_t len,
+                           ser::JonGUIState &state);
+
+  /**
+   * @brief Run an anomaly detector on the last valid message
+   *
+   * Anomalies are appended to the last result's warnings; they do not
+   * make the message invalid. Does nothing if the last message failed
+   * parsing or validation.
+   *
+   * @param detector Detector following the message's stream
+   * @param state Message from the last parse_and_validate()
+   * @param time_ns Frame time in ns
+   */
+  void check_anomalies (AnomalyDetector &detector,
+                        const ser::JonGUIState &state, int64_t time_ns);
+
   /**
    * @brief Get the last validation result
    * @return Validation result from last parse attempt
    */
   const ValidationResult &get_last_result () const { return last_result_; }
 
+  /**
+   * @brief Get how long the first validation waited for the factory
+   * @return Wait in ms (0 if the factory was ready or given directly)
+   */
+  double factory_wait_ms () const { return factory_wait_ms_; }
+
 private:
   /**
    * @brief Validate a parsed message
    * @param state The parsed state message
-   * @return Validation result
+   * @param result Receives is_valid and any errors
    */
-  ValidationResult validate (const ser::JonGUIState &state);
+  void validate (const ser::JonGUIState &state, ValidationResult &result);
 
   ValidationResult last_result_;
-  std::unique_ptr<buf::validate::ValidatorFactory> validator_factory_;
+  FactoryPtr validator_factory_;
+  FactoryFuture pending_factory_; // Until the first validation
+  double factory_wait_ms_ = 0.0;
   google::protobuf::Arena arena_;
 };
 
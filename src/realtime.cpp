@@ -0,0 +1,161 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 Jettison Project Team
+
+#include "realtime.h"
+#include "logger.h"
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <malloc.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sstream>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace jettison
+{
+
+bool
+parse_cpu_list (const std::string &text, std::vector<int> &cpus)
+{
+  std::istringstream list (text);
+  std::string item;
+  while (std::getline (list, item, ','))
+    {
+      const size_t dash = item.find ('-');
+      try
+        {
+          size_t used = 0;
+          const int first = std::stoi (item, &used);
+          int last = first;
+          if (dash != std::string::npos)
+            {
+              if (used != dash)
+                {
+                  return false;
+                }
+              last = std::stoi (item.substr (dash + 1), &used);
+              used += dash + 1;
+            }
+          if (used != item.size () || first < 0 || last < first)
+            {
+              return false;
+            }
+          for (int cpu = first; cpu <= last; ++cpu)
+            {
+              cpus.push_back (cpu);
+            }
+        }
+      catch (...)
+        {
+          return false;
+        }
+    }
+  return !cpus.empty ();
+}
+
+/**
+ * @brief Touch every page of a buffer so it is resident
+ */
+static void
+touch_pages (volatile char *buffer, size_t bytes)
+{
+  const auto page = static_cast<size_t> (sysconf (_SC_PAGESIZE));
+  for (size_t offset = 0; offset < bytes; offset += page)
+    {
+      buffer[offset] = 0;
+    }
+}
+
+bool
+prepare_process_memory (const RealtimeOptions &options)
+{
+  bool ok = true;
+
+  // Keep freed memory in the heap and never mmap individual allocations,
+  // so pre-faulted pages are reused rather than returned to the kernel
+  mallopt (M_TRIM_THRESHOLD, -1);
+  mallopt (M_MMAP_MAX, 0);
+
+  if (options.lock_memory && mlockall (MCL_CURRENT | MCL_FUTURE) != 0)
+    {
+      log_warning ("Warning: mlockall failed: ", std::strerror (errno),
+                   " (raise RLIMIT_MEMLOCK or run with CAP_IPC_LOCK)");
+      ok = false;
+    }
+
+  if (options.prefault_heap > 0)
+    {
+      auto *heap = static_cast<char *> (std::malloc (options.prefault_heap));
+      if (heap != nullptr)
+        {
+          touch_pages (heap, options.prefault_heap);
+          std::free (heap);
+        }
+    }
+
+  return ok;
+}
+
+/**
+ * @brief Fault in the top of the calling thread's stack
+ */
+static void __attribute__ ((noinline))
+prefault_stack (size_t bytes)
+{
+  auto *stack = static_cast<char *> (alloca (bytes));
+  touch_pages (stack, bytes);
+}
+
+bool
+apply_realtime (const RealtimeOptions &options, size_t slot,
+                const std::string &name)
+{
+  if (!options.enabled)
+    {
+      return true;
+    }
+
+  bool ok = true;
+
+  if (!options.cpus.empty ())
+    {
+      const int cpu = options.cpus[slot % options.cpus.size ()];
+      cpu_set_t set;
+      CPU_ZERO (&set);
+      CPU_SET (static_cast<size_t> (cpu), &set);
+      const int error = pthread_setaffinity_np (pthread_self (), sizeof (set),
+                                                &set);
+      if (error != 0)
+        {
+          log_warning ("Warning: cannot pin ", name, " to CPU ", cpu, ": ",
+                       std::strerror (error));
+          ok = false;
+        }
+    }
+
+  if (options.priority > 0)
+    {
+      sched_param param{};
+      param.sched_priority = options.priority;
+      const int error
+          = pthread_setschedparam (pthread_self (), SCHED_FIFO, &param);
+      if (error != 0)
+        {
+          log_warning ("Warning: cannot set SCHED_FIFO ", options.priority,
+                       " for ", name, ": ", std::strerror (error),
+                       " (needs CAP_SYS_NICE or an rtprio limit)");
+          ok = false;
+        }
+    }
+
+  if (options.prefault_stack > 0)
+    {
+      prefault_stack (options.prefault_stack);
+    }
+
+  return ok;
+}
+
+} // namespace jettison
@@ -0,0 +1,67 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 Jettison Project Team
+
+#ifndef REALTIME_H
+#define REALTIME_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace jettison
+{
+
+/**
+ * @brief Low-jitter runtime settings
+ */
+struct RealtimeOptions
+{
+  bool enabled = false;
+  std::vector<int> cpus; // Event loop on cpus[0], worker i on cpus[1 + i]
+                         // (wrapping); empty = no pinning
+  int priority = 0;      // SCHED_FIFO priority 1-99 (0 = keep SCHED_OTHER)
+  bool lock_memory = true;             // mlockall current and future pages
+  size_t prefault_heap = 16u << 20;    // Heap bytes to fault in up front
+  size_t prefault_stack = 256u << 10;  // Stack bytes per thread
+};
+
+/**
+ * @brief Parse a CPU list such as "2,3" or "0-3,6"
+ * @param text CPU list
+ * @param cpus Receives the CPU numbers
+ * @return true if the list is well-formed
+ */
+bool parse_cpu_list (const std::string &text, std::vector<int> &cpus);
+
+/**
+ * @brief Lock and pre-fault process memory
+ *
+ * Stops glibc from returning freed memory to the kernel or serving large
+ * allocations with fresh mmaps, locks all current and future pages, then
+ * touches options.prefault_heap bytes of heap so later allocations reuse
+ * resident, locked pages instead of faulting. Failures are reported on
+ * stderr and are not fatal.
+ *
+ * @param options Settings (lock_memory, prefault_heap)
+ * @return true if everything requested succeeded
+ */
+bool prepare_process_memory (const RealtimeOptions &options);
+
+/**
+ * @brief Apply pinning, scheduling and stack pre-faulting to the calling
+ * thread
+ *
+ * Failures (e.g. EPERM for SCHED_FIFO without CAP_SYS_NICE) are reported
+ * on stderr and are not fatal.
+ *
+ * @param options Settings
+ * @param slot 0 for the event loop thread, 1 + i for worker i
+ * @param name Thread name for messages
+ * @return true if everything requested succeeded
+ */
+bool apply_realtime (const RealtimeOptions &options, size_t slot,
+                     const std::string &name);
+
+} // namespace jettison
+
+#endif // REALTIME_H
@@ -0,0 +1,459 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 Jettison Project Team
+
+#include "receiver.h"
+#include "worker_pool.h"
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+
+namespace jettison
+{
+
+class Receiver::Impl
+{
+public:
+  using Clock = std::chrono::steady_clock;
+
+  explicit Impl (ReceiverOptions options)
+      : created_at_ (Clock::now ()), options_ (std::move (options)),
+        trackers_ (options_.endpoints.size ()),
+        targets_ (options_.endpoints.size ())
+  {
+    for (const auto &endpoint : options_.endpoints)
+      {
+        client_.add_target (endpoint);
+      }
+    if (options_.detect_anomalies)
+      {
+        for (auto &target : targets_)
+          {
+            target.anomalies
+                = std::make_unique<AnomalyDetector> (options_.anomaly);
+          }
+      }
+    // One ValidatorFactory shared by every processing thread, compiled
+    // in the background while the caller connects
+    factory_ = ProtoValidator::create_factory_async (&warmup_ms_);
+
+    client_.set_reconnect_policy (options_.reconnect);
+    client_.set_deflate_options (options_.deflate);
+
+    const RealtimeOptions &realtime = options_.realtime;
+    if (realtime.enabled)
+      {
+        prepare_process_memory (realtime);
+      }
+
+    for (size_t i = 0; i < std::max<size_t> (options_.workers, 1); ++i)
+      {
+        processors_.push_back (std::make_unique<Processor> (factory_));
+      }
+    if (realtime.enabled && !options_.sample_frame.empty ())
+      {
+        // Allocate the sub-messages of the reused state up front, in
+        // locked memory; parsing later frames then only overwrites them
+        const std::vector<uint8_t> &sample = options_.sample_frame;
+        for (auto &processor : processors_)
+          {
+            processor->state.ParseFromArray (sample.data (),
+                                             static_cast<int> (sample.size ()));
+          }
+      }
+    if (options_.workers > 0)
+      {
+        WorkerPool::ThreadInit init;
+        if (realtime.enabled)
+          {
+            init = [realtime] (size_t worker) {
+              apply_realtime (realtime, 1 + worker,
+                              "worker " + std::to_string (worker));
+            };
+          }
+        pool_ = std::make_unique<WorkerPool> (options_.workers,
+                                              options_.worker_queue_capacity,
+                                              std::move (init));
+      }
+
+    client_.set_message_callback (
+        [this] (size_t target, const uint8_t *data, size_t len) {
+          dispatch (target, data, len);
+        });
+  }
+
+  ~Impl ()
+  {
+    if (pool_)
+      {
+        pool_->stop ();
+      }
+  }
+
+  void
+  dispatch (size_t target, const uint8_t *data, size_t len)
+  {
+    const auto now = Clock::now ();
+
+    if (raw_callback_)
+      {
+        raw_callback_ (target, data, len);
+      }
+
+    // Classify in arrival order; repeats carry no new information
+    const FrameOrder order = trackers_[target].observe (data, len);
+    if (order == FrameOrder::Duplicate && options_.skip_duplicates)
+      {
+        return;
+      }
+
+    if (!pool_ && !handoff_callback_)
+      {
+        process (0, target, data, len, now, order, nullptr);
+        return;
+      }
+    if (!pool_)
+      {
+        // A handed-off payload must outlive the client's buffer
+        std::vector<uint8_t> &payload = processors_[0]->payload;
+        payload.assign (data, data + len);
+        process (0, target, payload.data (), len, now, order, &payload);
+        return;
+      }
+
+    // The payload is only valid during this call, so copy it into a
+    // recycled buffer
+    std::vector<uint8_t> payload = take_spare ();
+    payload.assign (data, data + len);
+    pool_->post (target, [this, target, payload = std::move (payload), now,
+                          order] (size_t worker) mutable {
+      process (worker, target, payload.data (), payload.size (), now, order,
+               &payload);
+      recycle (std::move (payload));
+    });
+  }
+
+  void
+  set_tick_callback (std::chrono::milliseconds interval,
+                     TickCallback callback)
+  {
+    tick_callback_ = std::move (callback);
+    client_.set_timer (interval, [this] { tick (); });
+  }
+
+  void
+  run ()
+  {
+    apply_realtime (options_.realtime, 0, "event loop");
+    client_.run ();
+    if (pool_)
+      {
+        pool_->stop ();
+      }
+  }
+
+  StartupStats
+  startup_stats () const
+  {
+    StartupStats stats;
+    if (factory_.wait_for (std::chrono::seconds (0))
+        == std::future_status::ready)
+      {
+        stats.warmup_ms = warmup_ms_;
+      }
+    const int64_t first_ns = first_validated_ns_.load ();
+    if (first_ns >= 0)
+      {
+        stats.first_validated_ms = static_cast<double> (first_ns) / 1e6;
+      }
+    for (const auto &processor : processors_)
+      {
+        stats.waited_ms = std::max (stats.waited_ms,
+                                    processor->validator.factory_wait_ms ());
+      }
+    return stats;
+  }
+
+  LatencyHistogram
+  latency () const
+  {
+    LatencyHistogram merged;
+    for (const auto &processor : processors_)
+      {
+        merged.merge (processor->latency);
+      }
+    return merged;
+  }
+
+  uint64_t
+  dropped_count () const
+  {
+    if (!pool_)
+      {
+        return 0;
+      }
+    // Skipped ticks are not frames; read first, as the pool counts them
+    // before ticks_skipped_ does
+    const uint64_t ticks = ticks_skipped_.load ();
+    return pool_->dropped_count () - ticks;
+  }
+
+  Clock::time_point created_at_;
+  ReceiverOptions options_;
+  WebSocketClient client_;
+  std::vector<SequenceTracker> trackers_; // Event loop thread only
+  std::vector<StateCallback> subscribers_;
+  RawCallback raw_callback_;
+  HandoffCallback handoff_callback_;
+
+private:
+  /**
+   * @brief Per-thread parsing state
+   */
+  struct Processor
+  {
+    explicit Processor (ProtoValidator::FactoryFuture factory)
+        : validator (std::move (factory))
+    {
+    }
+
+    ProtoValidator validator;
+    ser::JonGUIState state;       // Reused across frames
+    std::vector<uint8_t> payload; // Without workers, for the handoff
+    LatencyHistogram latency;     // Arrival to subscribers done
+  };
+
+  static constexpr size_t MAX_SPARE_PAYLOADS = 256;
+
+  std::vector<uint8_t>
+  take_spare ()
+  {
+    std::lock_guard<std::mutex> lock (spare_mutex_);
+    if (spare_payloads_.empty ())
+      {
+        return {};
+      }
+    std::vector<uint8_t> payload = std::move (spare_payloads_.back ());
+    spare_payloads_.pop_back ();
+    return payload;
+  }
+
+  void
+  recycle (std::vector<uint8_t> &&payload)
+  {
+    std::lock_guard<std::mutex> lock (spare_mutex_);
+    if (spare_payloads_.size () < MAX_SPARE_PAYLOADS)
+      {
+        spare_payloads_.push_back (std::move (payload));
+      }
+  }
+
+  /**
+   * @brief Per-target state, owned by the target's processing thread
+   */
+  struct TargetState
+  {
+    uint64_t sequence = 0;
+    std::unique_ptr<AnomalyDetector> anomalies; // When enabled
+  };
+
+  void
+  tick ()
+  {
+    for (size_t target = 0; target < targets_.size (); ++target)
+      {
+        if (!pool_)
+          {
+            tick_callback_ (target);
+            continue;
+          }
+        // Queued behind the target's frames, on the thread that owns it
+        auto task = [this, target] (size_t) { tick_callback_ (target); };
+        if (!pool_->post (target, std::move (task)))
+          {
+            ticks_skipped_++;
+          }
+      }
+  }
+
+  void
+  process (size_t worker, size_t target, const uint8_t *data, size_t len,
+           Clock::time_point received_at, FrameOrder order,
+           std::vector<uint8_t> *owned)
+  {
+    Processor &processor = *processors_[worker];
+    TargetState &target_state = targets_[target];
+    target_state.sequence++;
+
+    const bool parsed
+        = processor.validator.parse_and_validate (data, len, processor.state);
+    if (parsed && target_state.anomalies)
+      {
+        processor.validator.check_anomalies (
+            *target_state.anomalies, processor.state,
+            std::chrono::duration_cast<std::chrono::nanoseconds> (
+                received_at.time_since_epoch ())
+                .count ());
+      }
+    if (parsed && first_validated_ns_.load (std::memory_order_relaxed) < 0)
+      {
+        int64_t none = -1;
+        first_validated_ns_.compare_exchange_strong (
+            none, std::chrono::duration_cast<std::chrono::nanoseconds> (
+                      Clock::now () - created_at_)
+                      .count ());
+      }
+
+    const StateEvent event{ target,
+                            options_.endpoints[target],
+                            target_state.sequence,
+                            data,
+                            len,
+                            parsed ? &processor.state : nullptr,
+                            processor.validator.get_last_result (),
+                            received_at,
+                            order };
+
+    for (const auto &subscriber : subscribers_)
+      {
+        subscriber (event);
+      }
+    if (handoff_callback_ && owned != nullptr)
+      {
+        FrameBuffers buffers{ *owned, processor.state };
+        handoff_callback_ (event, buffers);
+      }
+    processor.latency.record (
+        std::chrono::duration_cast<std::chrono::nanoseconds> (Clock::now ()
+                                                              - received_at)
+            .count ());
+  }
+
+  double warmup_ms_ = 0.0; // Written before factory_ becomes ready
+  ProtoValidator::FactoryFuture factory_; // Waits for warm-up when destroyed
+  std::atomic<int64_t> first_validated_ns_{ -1 };
+  std::vector<std::unique_ptr<Processor>> processors_;
+  std::vector<TargetState> targets_;
+  std::unique_ptr<WorkerPool> pool_;
+  std::mutex spare_mutex_; // Payload buffers recycled between frames
+  std::vector<std::vector<uint8_t>> spare_payloads_;
+  TickCallback tick_callback_;
+  std::atomic<uint64_t> ticks_skipped_{ 0 }; // Counted by pool_ as dropped
+};
+
+Receiver::Receiver (ReceiverOptions options)
+    : pimpl_ (std::make_unique<Impl> (std::move (options)))
+{
+}
+
+Receiver::~Receiver () = default;
+
+void
+Receiver::subscribe (StateCallback callback)
+{
+  pimpl_->subscribers_.push_back (std::move (callback));
+}
+
+void
+Receiver::set_handoff_callback (HandoffCallback callback)
+{
+  pimpl_->handoff_callback_ = std::move (callback);
+}
+
+void
+Receiver::set_raw_callback (RawCallback callback)
+{
+  pimpl_->raw_callback_ = std::move (callback);
+}
+
+void
+Receiver::set_connection_callback (ConnectionCallback callback)
+{
+  pimpl_->client_.set_connection_callback (std::move (callback));
+}
+
+void
+Receiver::set_error_callback (ErrorCallback callback)
+{
+  pimpl_->client_.set_error_callback (std::move (callback));
+}
+
+void
+Receiver::set_status_callback (StatusCallback callback)
+{
+  pimpl_->client_.set_status_callback (std::move (callback));
+}
+
+void
+Receiver::set_tick_callback (std::chrono::milliseconds interval,
+                             TickCallback callback)
+{
+  pimpl_->set_tick_callback (interval, std::move (callback));
+}
+
+bool
+Receiver::start ()
+{
+  return pimpl_->client_.connect ();
+}
+
+void
+Receiver::run ()
+{
+  pimpl_->run ();
+}
+
+void
+Receiver::stop ()
+{
+  pimpl_->client_.disconnect ();
+}
+
+void
+Receiver::post (std::function<void ()> command)
+{
+  pimpl_->client_.post (std::move (command));
+}
+
+void
+Receiver::process_payload (size_t target, const uint8_t *data, size_t len)
+{
+  pimpl_->dispatch (target, data, len);
+}
+
+const std::vector<Endpoint> &
+Receiver::endpoints () const
+{
+  return pimpl_->options_.endpoints;
+}
+
+ConnectionStats
+Receiver::connection_stats (size_t target) const
+{
+  return pimpl_->client_.get_stats (target);
+}
+
+const SequenceStats &
+Receiver::sequence_stats (size_t target) const
+{
+  return pimpl_->trackers_[target].stats ();
+}
+
+StartupStats
+Receiver::startup_stats () const
+{
+  return pimpl_->startup_stats ();
+}
+
+LatencyHistogram
+Receiver::latency () const
+{
+  return pimpl_->latency ();
+}
+
+uint64_t
+Receiver::dropped_count () const
+{
+  return pimpl_->dropped_count ();
+}
+
+} // namespace jettison
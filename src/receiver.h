@@ -0,0 +1,301 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 Jettison Project Team
+
+#ifndef RECEIVER_H
+#define RECEIVER_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "jon_shared_data.pb.h"
+#include "latency_histogram.h"
+#include "proto_validator.h"
+#include "realtime.h"
+#include "sequence_tracker.h"
+#include "websocket_client.h"
+
+namespace jettison
+{
+
+/**
+ * @brief Configuration for a Receiver
+ */
+struct ReceiverOptions
+{
+  std::vector<Endpoint> endpoints; // Targets to connect to
+  size_t workers = 0;              // Validation threads (0 = event loop)
+  size_t worker_queue_capacity = 1024;
+  ReconnectPolicy reconnect;
+  DeflateOptions deflate;
+  bool detect_anomalies = false; // Add AnomalyDetector warnings per target
+  bool skip_duplicates = false;  // Drop repeated frames before parsing
+  AnomalyConfig anomaly;
+  RealtimeOptions realtime; // Pinning, SCHED_FIFO, locked memory
+  std::vector<uint8_t> sample_frame; // Realtime: a typical payload, parsed
+                                     // once to pre-grow each message
+};
+
+/**
+ * @brief Cold-start timings of a Receiver
+ */
+struct StartupStats
+{
+  double warmup_ms = 0.0;  // Background factory creation and rule compile
+  double first_validated_ms = -1.0; // Construction to first validated
+                                    // frame (-1 = none yet)
+  double waited_ms = 0.0; // How long the first frame waited for warm-up
+};
+
+/**
+ * @brief One received frame, as seen by subscribers
+ *
+ * Everything is passed by reference into the receiver's own buffers: the
+ * payload, the parsed message and the validation result are only valid
+ * for the duration of the callback. Copy what must outlive it.
+ */
+struct StateEvent
+{
+  size_t target;               // Index into ReceiverOptions::endpoints
+  const Endpoint &endpoint;    // Endpoint the frame came from
+  uint64_t sequence;           // Per-target frame number, starting at 1
+  const uint8_t *payload;      // Raw protobuf payload
+  size_t payload_len;          // Payload length in bytes
+  const ser::JonGUIState *state; // Parsed message, nullptr if parsing failed
+  const ValidationResult &validation; // Validation outcome
+  std::chrono::steady_clock::time_point received_at; // Arrival time
+  FrameOrder order; // New, or a Duplicate / Late arrival
+};
+
+/**
+ * @brief Buffers of one frame that a handoff callback may take over
+ *
+ * Swapping them with buffers of the same type hands the frame over
+ * without a copy. The receiver processes later frames in whatever it
+ * gets back, so handing back a recycled vector or message reuses its
+ * memory.
+ */
+struct FrameBuffers
+{
+  std::vector<uint8_t> &payload; // The event's payload
+  ser::JonGUIState &state; // The parsed message (stale if it did not parse)
+};
+
+/**
+ * @brief In-process receiver for Jettison state streams
+ *
+ * Wraps WebSocketClient, ProtoValidator and the worker pool behind a
+ * subscriber API: every complete frame is parsed once, validated once,
+ * and handed to all subscribers as a const reference, with no copy and
+ * no JSON step.
+ *
+ * Subscribers run on the thread that processed the frame: the event loop
+ * thread (workers = 0) or the worker owning the frame's target. Frames
+ * from one target are always delivered in order on the same thread.
+ */
+class Receiver
+{
+public:
+  using StateCallback = std::function<void (const StateEvent &event)>;
+  using RawCallback
+      = std::function<void (size_t target, const uint8_t *data, size_t len)>;
+  using ConnectionCallback = WebSocketClient::ConnectionCallback;
+  using ErrorCallback = WebSocketClient::ErrorCallback;
+  using StatusCallback = WebSocketClient::StatusCallback;
+  using TickCallback = std::function<void (size_t target)>;
+  using HandoffCallback
+      = std::function<void (const StateEvent &event, FrameBuffers &buffers)>;
+
+  /**
+   * @brief Construct a receiver
+   *
+   * Starts building and warming up the shared ValidatorFactory on a
+   * background thread, so it overlaps with the connection handshake
+   * made by start(); the first frame waits for it only if it is not
+   * done yet. With options.realtime enabled, process memory is locked
+   * and pre-faulted here, and each processor's message is grown by
+   * parsing options.sample_frame (if given), so the first frames do not
+   * page-fault.
+   *
+   * @param options Targets and processing options
+   */
+  explicit Receiver (ReceiverOptions options);
+  ~Receiver ();
+
+  // Non-copyable, non-movable
+  Receiver (const Receiver &) = delete;
+  Receiver &operator= (const Receiver &) = delete;
+  Receiver (Receiver &&) = delete;
+  Receiver &operator= (Receiver &&) = delete;
+
+  /**
+   * @brief Register a subscriber for parsed and validated frames
+   *
+   * Must be called before start().
+   *
+   * @param callback Function called for every frame
+   */
+  void subscribe (StateCallback callback);
+
+  /**
+   * @brief Set a callback that may take ownership of each frame
+   *
+   * Runs on the processing thread after every subscriber returned. The
+   * callback may swap the payload and the parsed message out of buffers
+   * (e.g. into a queued SinkGraph frame) instead of copying them; the
+   * event's payload and state pointers are invalid once it has. With a
+   * handoff callback, the event loop copies each payload out of the
+   * network buffer, as it always does with workers. Must be called
+   * before start().
+   *
+   * @param callback Function called last for every frame
+   */
+  void set_handoff_callback (HandoffCallback callback);
+
+  /**
+   * @brief Set a callback for raw payloads, before parsing
+   *
+   * Always runs on the event loop thread, before the frame is queued for
+   * validation. Useful for recording.
+   *
+   * @param callback Function called for every complete payload
+   */
+  void set_raw_callback (RawCallback callback);
+
+  /**
+   * @brief Set callback for connection status changes
+   * @param callback Function called when a target connects or disconnects
+   */
+  void set_connection_callback (ConnectionCallback callback);
+
+  /**
+   * @brief Set callback for errors
+   * @param callback Function called on connection errors
+   */
+  void set_error_callback (ErrorCallback callback);
+
+  /**
+   * @brief Set callback for informational state changes
+   * @param callback Function called e.g. when a reconnect is scheduled
+   */
+  void set_status_callback (StatusCallback callback);
+
+  /**
+   * @brief Set a callback run periodically for every target
+   *
+   * Each call runs on the target's processing thread, in order with its
+   * frames, so it may touch the same state as the subscribers. Ticks run
+   * whether or not frames arrive; a tick for a target whose worker queue
+   * is full is skipped. Must be called before start().
+   *
+   * @param interval Time between ticks
+   * @param callback Function called with each target index
+   */
+  void set_tick_callback (std::chrono::milliseconds interval,
+                          TickCallback callback);
+
+  /**
+   * @brief Connect to all endpoints
+   * @return true if at least one connection was initiated, or a retry is
+   *         scheduled (reconnect enabled)
+   */
+  bool start ();
+
+  /**
+   * @brief Run the event loop until stop() or all connections end
+   *
+   * Queued frames are processed before returning. With options.realtime
+   * enabled, the calling thread is pinned and scheduled first.
+   */
+  void run ();
+
+  /**
+   * @brief Stop the event loop (async-signal-safe, thread-safe)
+   */
+  void stop ();
+
+  /**
+   * @brief Run a command on the event loop thread (thread-safe)
+   * @param command Function to run
+   */
+  void post (std::function<void ()> command);
+
+  /**
+   * @brief Process a payload that did not come from the network
+   *
+   * Runs the normal pipeline (raw callback, parse, validate, subscribers)
+   * for an injected frame, e.g. one replayed from a dump. Call from the
+   * thread that owns the event loop (or instead of running it).
+   *
+   * @param target Target index the frame is attributed to
+   * @param data Pointer to binary data
+   * @param len Length of data in bytes
+   */
+  void process_payload (size_t target, const uint8_t *data, size_t len);
+
+  /**
+   * @brief Get the configured endpoints
+   * @return Endpoints, indexed by target
+   */
+  const std::vector<Endpoint> &endpoints () const;
+
+  /**
+   * @brief Get connection counters for a target
+   *
+   * Only call from the event loop thread or after run() returned.
+   *
+   * @param target Target index
+   * @return Connection statistics
+   */
+  ConnectionStats connection_stats (size_t target) const;
+
+  /**
+   * @brief Get gap, duplicate and reordering counters for a target
+   *
+   * Frames are classified on arrival, before parsing (see
+   * SequenceTracker). Only call from the event loop thread or after
+   * run() returned.
+   *
+   * @param target Target index
+   * @return Sequence statistics
+   */
+  const SequenceStats &sequence_stats (size_t target) const;
+
+  /**
+   * @brief Get cold-start timings
+   *
+   * Call after run() returned.
+   *
+   * @return Startup statistics
+   */
+  StartupStats startup_stats () const;
+
+  /**
+   * @brief Get the receive-to-delivered latency of every frame
+   *
+   * Measured from arrival on the event loop until all subscribers
+   * returned, so it includes queueing, parsing and validation. Call
+   * after run() returned.
+   *
+   * @return Merged histogram of all processing threads
+   */
+  LatencyHistogram latency () const;
+
+  /**
+   * @brief Get the number of frames dropped because workers fell behind
+   * @return Dropped frame count
+   */
+  uint64_t dropped_count () const;
+
+private:
+  class Impl;
+  std::unique_ptr<Impl> pimpl_;
+};
+
+} // namespace jettison
+
+#endif // RECEIVER_H
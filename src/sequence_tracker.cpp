@@ -0,0 +1,184 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 Jettison Project Team
+
+#include "sequence_tracker.h"
+#include "jon_shared_data.pb.h"
+#include <algorithm>
+#include <cmath>
+
+namespace jettison
+{
+
+namespace
+{
+
+/**
+ * @brief FNV-1a over the payload
+ */
+uint64_t
+payload_hash (const uint8_t *data, size_t len)
+{
+  uint64_t hash = 14695981039346656037ULL;
+  for (size_t i = 0; i < len; ++i)
+    {
+      hash = (hash ^ data[i]) * 1099511628211ULL;
+    }
+  return hash;
+}
+
+/**
+ * @brief Read a base-128 varint
+ * @return false on truncated or overlong input
+ */
+bool
+read_varint (const uint8_t *&p, const uint8_t *end, uint64_t &value)
+{
+  value = 0;
+  for (unsigned shift = 0; shift < 64 && p < end; shift += 7)
+    {
+      const uint8_t byte = *p++;
+      value |= static_cast<uint64_t> (byte & 0x7F) << shift;
+      if ((byte & 0x80) == 0)
+        {
+          return true;
+        }
+    }
+  return false;
+}
+
+} // namespace
+
+bool
+SequenceTracker::peek_timestamp (const uint8_t *data, size_t len,
+                                 uint64_t &time_us)
+{
+  constexpr uint64_t field
+      = ser::JonGUIState::kSystemMonotonicTimeUsFieldNumber;
+
+  // Walk top-level tags only; sub-messages are skipped by length
+  const uint8_t *p = data;
+  const uint8_t *const end = data + len;
+  while (p < end)
+    {
+      uint64_t tag = 0;
+      uint64_t value = 0;
+      if (!read_varint (p, end, tag))
+        {
+          return false;
+        }
+
+      switch (tag & 7)
+        {
+        case 0: // varint
+          if (!read_varint (p, end, value))
+            {
+              return false;
+            }
+          if ((tag >> 3) == field)
+            {
+              time_us = value;
+              return true;
+            }
+          break;
+        case 1: // 64-bit
+          if (end - p < 8)
+            {
+              return false;
+            }
+          p += 8;
+          break;
+        case 2: // length-delimited
+          if (!read_varint (p, end, value)
+              || value > static_cast<uint64_t> (end - p))
+            {
+              return false;
+            }
+          p += value;
+          break;
+        case 5: // 32-bit
+          if (end - p < 4)
+            {
+              return false;
+            }
+          p += 4;
+          break;
+        default: // groups are not used by the schema
+          return false;
+        }
+    }
+  return false;
+}
+
+FrameOrder
+SequenceTracker::observe (const uint8_t *data, size_t len)
+{
+  stats_.frames++;
+
+  // Exact repeats of a recent frame
+  const uint64_t hash = payload_hash (data, len);
+  for (const auto &recent : recent_)
+    {
+      if (recent.hash == hash && recent.len == len)
+        {
+          stats_.duplicates++;
+          return FrameOrder::Duplicate;
+        }
+    }
+  recent_[recent_next_] = Recent{ hash, len };
+  recent_next_ = (recent_next_ + 1) % DUPLICATE_WINDOW;
+
+  uint64_t time_us = 0;
+  if (!peek_timestamp (data, len, time_us))
+    {
+      return FrameOrder::New;
+    }
+  stats_.timestamped++;
+
+  if (!has_newest_)
+    {
+      newest_us_ = time_us;
+      has_newest_ = true;
+      return FrameOrder::New;
+    }
+
+  if (time_us < newest_us_)
+    {
+      if (newest_us_ - time_us > RESTART_US)
+        {
+          // Monotonic clock went back: the device restarted
+          stats_.restarts++;
+          newest_us_ = time_us;
+          return FrameOrder::New;
+        }
+
+      // A late frame fills part of a gap counted earlier
+      stats_.out_of_order++;
+      if (stats_.missing > 0)
+        {
+          stats_.missing--;
+        }
+      return FrameOrder::Late;
+    }
+
+  const auto step = static_cast<double> (time_us - newest_us_);
+  newest_us_ = time_us;
+  if (step == 0.0)
+    {
+      return FrameOrder::New;
+    }
+
+  double &interval = stats_.interval_us;
+  if (interval > 0.0 && step > 1.5 * interval)
+    {
+      stats_.gaps++;
+      stats_.missing += static_cast<uint64_t> (
+          std::max (std::llround (step / interval) - 1, 1LL));
+      return FrameOrder::New;
+    }
+
+  // Learn the frame period from regular steps only
+  interval = interval > 0.0 ? interval + (step - interval) / 16.0 : step;
+  return FrameOrder::New;
+}
+
+} // namespace jettison
@@ -0,0 +1,103 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 Jettison Project Team
+
+#ifndef SEQUENCE_TRACKER_H
+#define SEQUENCE_TRACKER_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace jettison
+{
+
+/**
+ * @brief Where a frame falls in its stream
+ */
+enum class FrameOrder : uint8_t
+{
+  New,       // Newer than every frame seen so far (or not timestamped)
+  Duplicate, // Byte-identical to a recent frame
+  Late       // Older than a frame already seen (arrived out of order)
+};
+
+/**
+ * @brief Stream continuity counters
+ */
+struct SequenceStats
+{
+  uint64_t frames = 0;       // Frames observed
+  uint64_t timestamped = 0;  // Frames carrying system_monotonic_time_us
+  uint64_t duplicates = 0;   // Byte-identical repeats of a recent frame
+  uint64_t out_of_order = 0; // Frames older than one already seen
+  uint64_t gaps = 0;         // Interruptions longer than 1.5 frame periods
+  uint64_t missing = 0;      // Frames estimated lost in gaps (minus late
+                             // arrivals that filled them)
+  uint64_t restarts = 0;     // Timestamp jumped back (device restarted)
+  double interval_us = 0.0;  // Estimated frame period
+};
+
+/**
+ * @brief Detects gaps, duplicates and reordering in a frame stream
+ *
+ * Works on the raw payload, before parsing, so duplicates can be
+ * dropped without paying for parse and validation. A frame's identity
+ * is its top-level system_monotonic_time_us, read with a shallow wire
+ * scan, plus a 64-bit hash of the payload:
+ * - a frame whose hash and length match one of the last DUPLICATE_WINDOW
+ *   frames is a duplicate;
+ * - a timestamp older than the newest seen is a late frame; one more
+ *   than RESTART_US older is taken as a device restart and resets the
+ *   tracker instead;
+ * - a step larger than 1.5 times the estimated frame period is a gap.
+ *
+ * Streams without timestamps get duplicate detection only. One tracker
+ * follows one stream; it is not thread-safe.
+ */
+class SequenceTracker
+{
+public:
+  static constexpr size_t DUPLICATE_WINDOW = 32;
+  static constexpr uint64_t RESTART_US = 5000000;
+
+  /**
+   * @brief Classify a frame and update the counters
+   * @param data Raw protobuf payload
+   * @param len Payload length in bytes
+   * @return Where the frame falls in the stream
+   */
+  FrameOrder observe (const uint8_t *data, size_t len);
+
+  /**
+   * @brief Get the counters
+   * @return Statistics so far
+   */
+  const SequenceStats &stats () const { return stats_; }
+
+  /**
+   * @brief Read the top-level system_monotonic_time_us without parsing
+   * @param data Raw JonGUIState payload
+   * @param len Payload length in bytes
+   * @param time_us Receives the timestamp
+   * @return true if the field was found
+   */
+  static bool peek_timestamp (const uint8_t *data, size_t len,
+                              uint64_t &time_us);
+
+private:
+  struct Recent
+  {
+    uint64_t hash = 0;
+    size_t len = 0;
+  };
+
+  SequenceStats stats_;
+  std::array<Recent, DUPLICATE_WINDOW> recent_{};
+  size_t recent_next_ = 0;
+  uint64_t newest_us_ = 0;
+  bool has_newest_ = false;
+};
+
+} // namespace jettison
+
+#endif // SEQUENCE_TRACKER_H
@@ -0,0 +1,259 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 Jettison Project Team
+
+#include "shm_state.h"
+#include "logger.h"
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace jettison
+{
+
+namespace
+{
+
+constexpr uint32_t SHM_MAGIC = 0x4A535452; // "JSTR"
+constexpr uint32_t SHM_LAYOUT_VERSION = 1;
+
+} // namespace
+
+/**
+ * @brief Shared-memory layout
+ *
+ * `seq` is the seqlock: odd while a write is in progress. Everything
+ * after it is only meaningful when read between two equal, even values.
+ */
+struct ShmRegion
+{
+  uint32_t magic;
+  uint32_t layout_version;
+  uint64_t capacity;
+  alignas (64) std::atomic<uint64_t> seq;
+  uint64_t sequence;
+  int64_t published_ns;
+  uint32_t target;
+  uint32_t payload_len;
+  alignas (64) uint8_t payload[1]; // capacity bytes
+};
+
+static_assert (std::atomic<uint64_t>::is_always_lock_free,
+               "seqlock needs a lock-free 64-bit atomic in shared memory");
+
+static size_t
+region_size (size_t capacity)
+{
+  return offsetof (ShmRegion, payload) + capacity;
+}
+
+ShmPublisher::ShmPublisher (std::string name, size_t capacity)
+    : name_ (std::move (name))
+{
+  const int fd = shm_open (name_.c_str (), O_CREAT | O_RDWR, 0644);
+  if (fd < 0)
+    {
+      log_error ("Failed to create shared memory ", name_, ": ",
+                 std::strerror (errno));
+      return;
+    }
+
+  const size_t size = region_size (capacity);
+  if (ftruncate (fd, static_cast<off_t> (size)) != 0)
+    {
+      log_error ("Failed to size shared memory ", name_, ": ",
+                 std::strerror (errno));
+      close (fd);
+      return;
+    }
+
+  void *addr = mmap (nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close (fd);
+  if (addr == MAP_FAILED)
+    {
+      log_error ("Failed to map shared memory ", name_, ": ",
+                 std::strerror (errno));
+      return;
+    }
+
+  region_ = static_cast<ShmRegion *> (addr);
+  mapped_size_ = size;
+
+  // Start at an even version with no payload; magic last, so readers
+  // never accept a half-initialized header
+  region_->layout_version = SHM_LAYOUT_VERSION;
+  region_->capacity = capacity;
+  region_->sequence = 0;
+  region_->published_ns = 0;
+  region_->target = 0;
+  region_->payload_len = 0;
+  region_->seq.store (0, std::memory_order_relaxed);
+  std::atomic_thread_fence (std::memory_order_release);
+  region_->magic = SHM_MAGIC;
+}
+
+ShmPublisher::~ShmPublisher ()
+{
+  if (region_ != nullptr)
+    {
+      munmap (region_, mapped_size_);
+      shm_unlink (name_.c_str ());
+    }
+}
+
+bool
+ShmPublisher::publish (const uint8_t *data, size_t len, uint64_t sequence,
+                       uint32_t target)
+{
+  if (region_ == nullptr)
+    {
+      return false;
+    }
+  if (len > region_->capacity)
+    {
+      oversized_++;
+      return false;
+    }
+
+  const auto now = std::chrono::steady_clock::now ().time_since_epoch ();
+  const uint64_t seq = region_->seq.load (std::memory_order_relaxed);
+
+  // Odd: write in progress
+  region_->seq.store (seq + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence (std::memory_order_release);
+
+  region_->sequence = sequence;
+  region_->published_ns
+      = std::chrono::duration_cast<std::chrono::nanoseconds> (now).count ();
+  region_->target = target;
+  region_->payload_len = static_cast<uint32_t> (len);
+  std::memcpy (region_->payload, data, len);
+
+  // Even again: consistent
+  region_->seq.store (seq + 2, std::memory_order_release);
+  return true;
+}
+
+ShmReader::ShmReader (std::string name) : name_ (std::move (name))
+{
+  const int fd = shm_open (name_.c_str (), O_RDONLY, 0);
+  if (fd < 0)
+    {
+      log_error ("Failed to open shared memory ", name_, ": ",
+                 std::strerror (errno));
+      return;
+    }
+
+  struct stat st{};
+  if (fstat (fd, &st) != 0
+      || static_cast<size_t> (st.st_size) < region_size (0))
+    {
+      log_error ("Shared memory ", name_, " is not a state region");
+      close (fd);
+      return;
+    }
+
+  const auto size = static_cast<size_t> (st.st_size);
+  void *addr = mmap (nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+  close (fd);
+  if (addr == MAP_FAILED)
+    {
+      log_error ("Failed to map shared memory ", name_, ": ",
+                 std::strerror (errno));
+      return;
+    }
+
+  const auto *region = static_cast<const ShmRegion *> (addr);
+  std::atomic_thread_fence (std::memory_order_acquire);
+  if (region->magic != SHM_MAGIC
+      || region->layout_version != SHM_LAYOUT_VERSION
+      || region_size (region->capacity) > size)
+    {
+      log_error ("Shared memory ", name_,
+                 " has an unknown layout or is not initialized");
+      munmap (addr, size);
+      return;
+    }
+
+  region_ = region;
+  mapped_size_ = size;
+}
+
+ShmReader::~ShmReader ()
+{
+  if (region_ != nullptr)
+    {
+      munmap (const_cast<ShmRegion *> (region_), mapped_size_);
+    }
+}
+
+uint64_t
+ShmReader::version () const
+{
+  if (region_ == nullptr)
+    {
+      return 0;
+    }
+  return region_->seq.load (std::memory_order_acquire);
+}
+
+bool
+ShmReader::read (ShmSnapshot &snapshot, int max_attempts) const
+{
+  if (region_ == nullptr)
+    {
+      return false;
+    }
+
+  for (int attempt = 0; attempt < max_attempts; ++attempt)
+    {
+      const uint64_t before = region_->seq.load (std::memory_order_acquire);
+      if (before == 0)
+        {
+          return false; // Nothing published yet
+        }
+      if ((before & 1U) != 0)
+        {
+          continue; // Writer active
+        }
+
+      const uint32_t len = region_->payload_len;
+      if (len > region_->capacity)
+        {
+          continue; // Torn length, the version check below would fail
+        }
+      snapshot.sequence = region_->sequence;
+      snapshot.target = region_->target;
+      const int64_t published_ns = region_->published_ns;
+      snapshot.payload.resize (len);
+      std::memcpy (snapshot.payload.data (), region_->payload, len);
+
+      std::atomic_thread_fence (std::memory_order_acquire);
+      if (region_->seq.load (std::memory_order_relaxed) == before)
+        {
+          snapshot.version = before;
+          snapshot.published_at = std::chrono::steady_clock::time_point (
+              std::chrono::duration_cast<std::chrono::steady_clock::duration> (
+                  std::chrono::nanoseconds (published_ns)));
+          return true;
+        }
+    }
+
+  return false;
+}
+
+bool
+ShmReader::read_state (ser::JonGUIState &state, ShmSnapshot &snapshot) const
+{
+  if (!read (snapshot))
+    {
+      return false;
+    }
+  return state.ParseFromArray (snapshot.payload.data (),
+                               static_cast<int> (snapshot.payload.size ()));
+}
+
+} // namespace jettison
@@ -0,0 +1,162 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 Jettison Project Team
+
+#ifndef SHM_STATE_H
+#define SHM_STATE_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "jon_shared_data.pb.h"
+
+namespace jettison
+{
+
+struct ShmRegion;
+
+/**
+ * @brief Latest-state snapshot read from shared memory
+ */
+struct ShmSnapshot
+{
+  uint64_t version = 0;  // Seqlock version; changes on every publish
+  uint64_t sequence = 0; // Publisher's frame number
+  uint32_t target = 0;   // Publisher's target index
+  std::chrono::steady_clock::time_point published_at; // Publish time
+  std::vector<uint8_t> payload; // Serialized JonGUIState
+};
+
+/**
+ * @brief Publishes the latest validated payload to POSIX shared memory
+ *
+ * The region holds one serialized JonGUIState guarded by a seqlock: the
+ * writer never blocks, and readers retry if they raced with a write.
+ * There must be a single writer per region.
+ */
+class ShmPublisher
+{
+public:
+  static constexpr size_t DEFAULT_CAPACITY = 64 * 1024;
+
+  /**
+   * @brief Create (or take over) a shared-memory region
+   * @param name POSIX shm name, e.g. "/jettison_state"
+   * @param capacity Maximum payload size in bytes
+   */
+  explicit ShmPublisher (std::string name,
+                         size_t capacity = DEFAULT_CAPACITY);
+
+  /**
+   * @brief Unmap and unlink the region
+   *
+   * Readers that already mapped it keep their last snapshot.
+   */
+  ~ShmPublisher ();
+
+  // Non-copyable, non-movable
+  ShmPublisher (const ShmPublisher &) = delete;
+  ShmPublisher &operator= (const ShmPublisher &) = delete;
+  ShmPublisher (ShmPublisher &&) = delete;
+  ShmPublisher &operator= (ShmPublisher &&) = delete;
+
+  /**
+   * @brief Check whether the region was created and mapped
+   * @return true if publish() can be used
+   */
+  bool is_open () const { return region_ != nullptr; }
+
+  /**
+   * @brief Publish a payload as the latest state
+   * @param data Serialized JonGUIState
+   * @param len Payload length in bytes
+   * @param sequence Frame number to publish alongside
+   * @param target Target index to publish alongside
+   * @return false if the payload exceeds the region capacity
+   */
+  bool publish (const uint8_t *data, size_t len, uint64_t sequence,
+                uint32_t target = 0);
+
+  /**
+   * @brief Get the number of payloads too large for the region
+   * @return Oversized payload count
+   */
+  uint64_t oversized_count () const { return oversized_; }
+
+  /**
+   * @brief Get the region name
+   * @return POSIX shm name
+   */
+  const std::string &name () const { return name_; }
+
+private:
+  std::string name_;
+  ShmRegion *region_ = nullptr;
+  size_t mapped_size_ = 0;
+  uint64_t oversized_ = 0;
+};
+
+/**
+ * @brief Reads the latest state from a ShmPublisher region
+ *
+ * Reading never takes a lock and never blocks the publisher; a read that
+ * overlaps a write is retried a bounded number of times.
+ */
+class ShmReader
+{
+public:
+  /**
+   * @brief Map an existing region read-only
+   * @param name POSIX shm name used by the publisher
+   */
+  explicit ShmReader (std::string name);
+  ~ShmReader ();
+
+  // Non-copyable, non-movable
+  ShmReader (const ShmReader &) = delete;
+  ShmReader &operator= (const ShmReader &) = delete;
+  ShmReader (ShmReader &&) = delete;
+  ShmReader &operator= (ShmReader &&) = delete;
+
+  /**
+   * @brief Check whether the region was found and mapped
+   * @return true if reads can be attempted
+   */
+  bool is_open () const { return region_ != nullptr; }
+
+  /**
+   * @brief Get the current seqlock version without copying anything
+   *
+   * Compare with ShmSnapshot::version to poll cheaply for updates.
+   *
+   * @return Current version (0 if nothing was published yet)
+   */
+  uint64_t version () const;
+
+  /**
+   * @brief Copy the latest payload
+   * @param snapshot Receives the payload and metadata (buffer is reused)
+   * @param max_attempts Retries allowed while racing with the writer
+   * @return true on a consistent read of a published state
+   */
+  bool read (ShmSnapshot &snapshot, int max_attempts = 64) const;
+
+  /**
+   * @brief Read and parse the latest state
+   * @param state Receives the parsed message
+   * @param snapshot Scratch snapshot (buffer is reused)
+   * @return true if a consistent payload was read and parsed
+   */
+  bool read_state (ser::JonGUIState &state, ShmSnapshot &snapshot) const;
+
+private:
+  std::string name_;
+  const ShmRegion *region_ = nullptr;
+  size_t mapped_size_ = 0;
+};
+
+} // namespace jettison
+
+#endif // SHM_STATE_H
@@ -0,0 +1,336 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 Jettison Project Team
+
+#include "sink_graph.h"
+#include <utility>
+
+namespace jettison
+{
+
+std::optional<OverflowPolicy>
+parse_overflow_policy (const std::string &name)
+{
+  if (name == "drop-newest")
+    {
+      return OverflowPolicy::DropNewest;
+    }
+  if (name == "drop-oldest")
+    {
+      return OverflowPolicy::DropOldest;
+    }
+  if (name == "block")
+    {
+      return OverflowPolicy::Block;
+    }
+  return std::nullopt;
+}
+
+const char *
+overflow_policy_name (OverflowPolicy policy)
+{
+  switch (policy)
+    {
+    case OverflowPolicy::DropOldest:
+      return "drop-oldest";
+    case OverflowPolicy::Block:
+      return "block";
+    case OverflowPolicy::DropNewest:
+    default:
+      return "drop-newest";
+    }
+}
+
+FrameRef::FrameRef (SharedFrame *frame) : frame_ (frame)
+{
+  if (frame_ != nullptr)
+    {
+      frame_->refs_.fetch_add (1, std::memory_order_relaxed);
+    }
+}
+
+FrameRef::FrameRef (const FrameRef &other) : FrameRef (other.frame_) {}
+
+FrameRef::FrameRef (FrameRef &&other) noexcept
+    : frame_ (std::exchange (other.frame_, nullptr))
+{
+}
+
+FrameRef &
+FrameRef::operator= (FrameRef other) noexcept
+{
+  std::swap (frame_, other.frame_);
+  return *this;
+}
+
+FrameRef::~FrameRef ()
+{
+  if (frame_ != nullptr
+      && frame_->refs_.fetch_sub (1, std::memory_order_acq_rel) == 1)
+    {
+      frame_->graph_->release (frame_);
+    }
+}
+
+SinkGraph::~SinkGraph () { stop (); }
+
+size_t
+SinkGraph::add (const std::string &name, const SinkOptions &options,
+                SinkFunction write, IdleFunction idle)
+{
+  auto sink = std::make_unique<Sink> ();
+  sink->name = name;
+  sink->options = options;
+  if (sink->options.capacity == 0)
+    {
+      sink->options.capacity = 1;
+    }
+  sink->write = std::move (write);
+  sink->idle = std::move (idle);
+  sink->ring.resize (sink->options.capacity);
+  sinks_.push_back (std::move (sink));
+  return sinks_.size () - 1;
+}
+
+void
+SinkGraph::start ()
+{
+  if (started_)
+    {
+      return;
+    }
+  started_ = true;
+  for (auto &sink : sinks_)
+    {
+      Sink *target = sink.get ();
+      sink->thread = std::thread ([this, target] () { run (*target); });
+    }
+}
+
+bool
+SinkGraph::accepts (const Sink &sink, const SharedFrame &frame)
+{
+  switch (sink.options.input)
+    {
+    case SinkInput::Parsed:
+      return frame.parsed_;
+    case SinkInput::Valid:
+      return frame.valid_;
+    case SinkInput::All:
+    default:
+      return true;
+    }
+}
+
+void
+SinkGraph::publish (const StateEvent &event, FrameBuffers &buffers)
+{
+  if (sinks_.empty ())
+    {
+      return;
+    }
+
+  SharedFrame *frame = acquire ();
+  frame->target_ = event.target;
+  frame->sequence_ = event.sequence;
+  frame->received_at_ = event.received_at;
+  frame->published_ns_
+      = std::chrono::duration_cast<std::chrono::nanoseconds> (
+            std::chrono::system_clock::now ().time_since_epoch ())
+            .count ();
+  frame->parsed_ = event.state != nullptr;
+  frame->valid_ = frame->parsed_ && event.validation.is_valid;
+
+  // Take the receiver's buffers, leaving it the frame's old ones to reuse
+  frame->payload_.swap (buffers.payload);
+
+  // Sinks share the receiver's parse rather than each parsing again
+  frame->has_state_ = false;
+  if (frame->parsed_)
+    {
+      for (const auto &sink : sinks_)
+        {
+          if (sink->options.needs_state && accepts (*sink, *frame))
+            {
+              frame->state_.Swap (&buffers.state);
+              frame->has_state_ = true;
+              break;
+            }
+        }
+    }
+
+  // The publisher's reference is dropped on return, so a frame no sink
+  // accepted goes straight back to the pool
+  const FrameRef ref (frame);
+  for (auto &sink : sinks_)
+    {
+      if (accepts (*sink, *frame))
+        {
+          enqueue (*sink, ref);
+        }
+    }
+}
+
+void
+SinkGraph::enqueue (Sink &sink, const FrameRef &frame)
+{
+  FrameRef evicted; // Released outside the lock
+  {
+    std::unique_lock<std::mutex> lock (sink.mutex);
+    const size_t capacity = sink.ring.size ();
+    if (sink.count == capacity)
+      {
+        switch (sink.options.overflow)
+          {
+          case OverflowPolicy::Block:
+            sink.not_full.wait (lock, [&] () {
+              return sink.stopping || sink.count < capacity;
+            });
+            if (sink.stopping)
+              {
+                sink.stats.dropped++;
+                return;
+              }
+            break;
+          case OverflowPolicy::DropOldest:
+            evicted = std::move (sink.ring[sink.head]);
+            sink.head = (sink.head + 1) % capacity;
+            sink.count--;
+            sink.stats.dropped++;
+            break;
+          case OverflowPolicy::DropNewest:
+          default:
+            sink.stats.dropped++;
+            return;
+          }
+      }
+
+    sink.ring[(sink.head + sink.count) % capacity] = frame;
+    sink.count++;
+    if (sink.count > sink.stats.peak)
+      {
+        sink.stats.peak = sink.count;
+      }
+  }
+  sink.not_empty.notify_one ();
+}
+
+void
+SinkGraph::run (Sink &sink)
+{
+  std::vector<FrameRef> batch;
+  batch.reserve (sink.ring.size ());
+
+  for (;;)
+    {
+      {
+        std::unique_lock<std::mutex> lock (sink.mutex);
+        sink.not_empty.wait (
+            lock, [&] () { return sink.stopping || sink.count > 0; });
+
+        // Drain the queue before exiting
+        if (sink.count == 0)
+          {
+            return;
+          }
+
+        // Take everything queued at once, so the publisher contends for
+        // the lock once per batch rather than once per frame
+        const size_t capacity = sink.ring.size ();
+        for (; sink.count > 0; sink.count--)
+          {
+            batch.push_back (std::move (sink.ring[sink.head]));
+            sink.head = (sink.head + 1) % capacity;
+          }
+        sink.head = 0;
+      }
+      if (sink.options.overflow == OverflowPolicy::Block)
+        {
+          sink.not_full.notify_all ();
+        }
+
+      for (const auto &frame : batch)
+        {
+          sink.write (*frame);
+        }
+      {
+        std::lock_guard<std::mutex> lock (sink.mutex);
+        sink.stats.written += batch.size ();
+      }
+      batch.clear ();
+
+      if (sink.idle)
+        {
+          std::unique_lock<std::mutex> lock (sink.mutex);
+          if (sink.count == 0)
+            {
+              lock.unlock ();
+              sink.idle ();
+            }
+        }
+    }
+}
+
+void
+SinkGraph::stop ()
+{
+  for (auto &sink : sinks_)
+    {
+      {
+        std::lock_guard<std::mutex> lock (sink->mutex);
+        sink->stopping = true;
+      }
+      sink->not_empty.notify_all ();
+      sink->not_full.notify_all ();
+    }
+
+  for (auto &sink : sinks_)
+    {
+      if (sink->thread.joinable ())
+        {
+          sink->thread.join ();
+        }
+    }
+}
+
+const std::string &
+SinkGraph::name (size_t sink) const
+{
+  return sinks_[sink]->name;
+}
+
+const SinkOptions &
+SinkGraph::options (size_t sink) const
+{
+  return sinks_[sink]->options;
+}
+
+SinkStats
+SinkGraph::stats (size_t sink) const
+{
+  std::lock_guard<std::mutex> lock (sinks_[sink]->mutex);
+  return sinks_[sink]->stats;
+}
+
+SharedFrame *
+SinkGraph::acquire ()
+{
+  std::lock_guard<std::mutex> lock (pool_mutex_);
+  if (free_.empty ())
+    {
+      frames_.push_back (std::make_unique<SharedFrame> ());
+      frames_.back ()->graph_ = this;
+      return frames_.back ().get ();
+    }
+  SharedFrame *frame = free_.back ();
+  free_.pop_back ();
+  return frame;
+}
+
+void
+SinkGraph::release (SharedFrame *frame)
+{
+  std::lock_guard<std::mutex> lock (pool_mutex_);
+  free_.push_back (frame);
+}
+
+} // namespace jettison
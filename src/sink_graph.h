@@ -0,0 +1,297 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 Jettison Project Team
+
+#ifndef SINK_GRAPH_H
+#define SINK_GRAPH_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "jon_shared_data.pb.h"
+#include "receiver.h"
+
+namespace jettison
+{
+
+class SinkGraph;
+
+/**
+ * @brief What a sink does when its queue is full
+ */
+enum class OverflowPolicy
+{
+  DropNewest, // Keep what is queued, drop the incoming frame
+  DropOldest, // Make room by dropping the oldest queued frame
+  Block       // Wait for room (stalls the publishing thread)
+};
+
+/**
+ * @brief Parse a policy name
+ * @param name "drop-newest", "drop-oldest" or "block"
+ * @return Policy, or std::nullopt if unknown
+ */
+std::optional<OverflowPolicy> parse_overflow_policy (const std::string &name);
+
+/**
+ * @brief Get the name of a policy
+ * @param policy Policy
+ * @return Name as accepted by parse_overflow_policy()
+ */
+const char *overflow_policy_name (OverflowPolicy policy);
+
+/**
+ * @brief Which frames a sink receives
+ */
+enum class SinkInput
+{
+  All,    // Every frame, including unparsable ones
+  Parsed, // Frames that parsed, valid or not
+  Valid   // Frames that passed validation
+};
+
+/**
+ * @brief Queue configuration of a sink
+ */
+struct SinkOptions
+{
+  size_t capacity = 1024; // Frames queued at most
+  OverflowPolicy overflow = OverflowPolicy::DropNewest;
+  SinkInput input = SinkInput::All;
+  bool needs_state = true; // The sink reads SharedFrame::state()
+};
+
+/**
+ * @brief Per-sink counters
+ */
+struct SinkStats
+{
+  uint64_t written = 0; // Frames handed to the sink
+  uint64_t dropped = 0; // Frames lost to a full queue
+  size_t peak = 0;      // Deepest the queue has been
+};
+
+/**
+ * @brief One published frame, shared read-only by every sink
+ *
+ * On publish the frame takes over the receiver's payload buffer, and the
+ * message the receiver already parsed when a sink accepting the frame
+ * needs it, by swapping them with its own from an earlier frame. Sinks
+ * then get the same frame by reference, without copying or parsing
+ * again. Frames are pooled and return to the pool once the last
+ * reference is released, keeping their buffers for the next swap.
+ */
+class SharedFrame
+{
+public:
+  size_t target () const { return target_; }     // Receiver target index
+  uint64_t sequence () const { return sequence_; } // Per-target frame number
+  std::chrono::steady_clock::time_point received_at () const
+  {
+    return received_at_;
+  }
+  int64_t published_ns () const { return published_ns_; } // Unix time
+  bool parsed () const { return parsed_; } // The receiver parsed it
+  bool valid () const { return valid_; }   // ...and it passed validation
+  const uint8_t *payload () const { return payload_.data (); }
+  size_t payload_len () const { return payload_.size (); }
+
+  /**
+   * @brief Get the parsed message
+   * @return Message parsed by the receiver, nullptr if it did not parse
+   *         or no sink receiving the frame set SinkOptions::needs_state
+   */
+  const ser::JonGUIState *
+  state () const
+  {
+    return has_state_ ? &state_ : nullptr;
+  }
+
+private:
+  friend class SinkGraph;
+  friend class FrameRef;
+
+  size_t target_ = 0;
+  uint64_t sequence_ = 0;
+  std::chrono::steady_clock::time_point received_at_;
+  int64_t published_ns_ = 0;
+  bool parsed_ = false;
+  bool valid_ = false;
+  std::vector<uint8_t> payload_;
+  bool has_state_ = false;
+  ser::JonGUIState state_;
+
+  std::atomic<uint32_t> refs_{ 0 };
+  SinkGraph *graph_ = nullptr;
+};
+
+/**
+ * @brief Counted reference to a SharedFrame
+ */
+class FrameRef
+{
+public:
+  FrameRef () = default;
+  explicit FrameRef (SharedFrame *frame);
+  FrameRef (const FrameRef &other);
+  FrameRef (FrameRef &&other) noexcept;
+  FrameRef &operator= (FrameRef other) noexcept;
+  ~FrameRef ();
+
+  const SharedFrame &operator* () const { return *frame_; }
+  const SharedFrame *operator->() const { return frame_; }
+  explicit operator bool () const { return frame_ != nullptr; }
+
+private:
+  SharedFrame *frame_ = nullptr;
+};
+
+/**
+ * @brief Fans validated frames out to independent output sinks
+ *
+ * Each sink (a dump writer, an NDJSON stream, a shared-memory region, a
+ * column recorder...) has its own bounded queue and its own thread. A
+ * frame is published once: its payload (and parsed message, if a sink
+ * needs it) is swapped into a pooled SharedFrame and a reference is
+ * queued for every sink that accepts it, so the cost on the publishing
+ * thread is a short lock per sink, whatever the sinks do. A sink that
+ * falls behind only fills its own queue; its overflow policy decides
+ * which of its frames are lost, and the other sinks are not delayed.
+ * Only OverflowPolicy::Block lets a slow sink stall the publisher, and
+ * with it every other sink.
+ *
+ * Frames from one publishing thread reach each sink in publish order.
+ * Each sink function runs on one thread only, so it may use its writers
+ * without locking.
+ */
+class SinkGraph
+{
+public:
+  using SinkFunction = std::function<void (const SharedFrame &frame)>;
+  using IdleFunction = std::function<void ()>;
+
+  SinkGraph () = default;
+
+  /**
+   * @brief Stop all sinks, writing what is queued
+   */
+  ~SinkGraph ();
+
+  // Non-copyable, non-movable (frames point back to the graph)
+  SinkGraph (const SinkGraph &) = delete;
+  SinkGraph &operator= (const SinkGraph &) = delete;
+  SinkGraph (SinkGraph &&) = delete;
+  SinkGraph &operator= (SinkGraph &&) = delete;
+
+  /**
+   * @brief Add a sink
+   *
+   * Must be called before start().
+   *
+   * @param name Name used in statistics
+   * @param options Queue capacity, overflow policy and input filter
+   * @param write Function called with each frame, on the sink's thread
+   * @param idle Optional function called whenever the queue has been
+   *             drained, e.g. to flush a stream
+   * @return Sink index
+   */
+  size_t add (const std::string &name, const SinkOptions &options,
+              SinkFunction write, IdleFunction idle = nullptr);
+
+  /**
+   * @brief Start one thread per sink
+   */
+  void start ();
+
+  /**
+   * @brief Publish a frame to every sink accepting it (thread-safe)
+   *
+   * Meant to be called from Receiver::set_handoff_callback(). The
+   * payload and, when a sink needs it, the parsed message are swapped
+   * out of buffers, which get the buffers of a recycled frame in
+   * exchange; nothing else is kept.
+   *
+   * @param event Frame from the receiver
+   * @param buffers The event's payload and message, taken over
+   */
+  void publish (const StateEvent &event, FrameBuffers &buffers);
+
+  /**
+   * @brief Deliver everything queued and join the sink threads
+   */
+  void stop ();
+
+  /**
+   * @brief Get the number of sinks
+   * @return Sink count
+   */
+  size_t size () const { return sinks_.size (); }
+
+  /**
+   * @brief Get a sink's name
+   * @param sink Sink index
+   * @return Name given to add()
+   */
+  const std::string &name (size_t sink) const;
+
+  /**
+   * @brief Get a sink's queue configuration
+   * @param sink Sink index
+   * @return Options given to add()
+   */
+  const SinkOptions &options (size_t sink) const;
+
+  /**
+   * @brief Get a sink's counters (thread-safe)
+   * @param sink Sink index
+   * @return Statistics
+   */
+  SinkStats stats (size_t sink) const;
+
+private:
+  friend class FrameRef;
+
+  struct Sink
+  {
+    std::string name;
+    SinkOptions options;
+    SinkFunction write;
+    IdleFunction idle;
+
+    mutable std::mutex mutex;
+    std::condition_variable not_empty;
+    std::condition_variable not_full;
+    std::vector<FrameRef> ring; // capacity slots
+    size_t head = 0;
+    size_t count = 0;
+    bool stopping = false;
+    SinkStats stats;
+    std::thread thread;
+  };
+
+  static bool accepts (const Sink &sink, const SharedFrame &frame);
+  void enqueue (Sink &sink, const FrameRef &frame);
+  void run (Sink &sink);
+  SharedFrame *acquire ();
+  void release (SharedFrame *frame);
+
+  std::vector<std::unique_ptr<Sink>> sinks_;
+  bool started_ = false;
+
+  std::mutex pool_mutex_;
+  std::vector<std::unique_ptr<SharedFrame>> frames_; // Every frame made
+  std::vector<SharedFrame *> free_;                  // Ready for reuse
+};
+
+} // namespace jettison
+
+#endif // SINK_GRAPH_H
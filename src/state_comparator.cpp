@@ -0,0 +1,241 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 Jettison Project Team
+
+#include "state_comparator.h"
+#include <algorithm>
+#include <cmath>
+
+namespace jettison
+{
+
+std::optional<CompareSpec>
+parse_compare_spec (const std::string &spec)
+{
+  CompareSpec result;
+  const size_t first = spec.find (':');
+  result.path = spec.substr (0, first);
+  if (first == std::string::npos)
+    {
+      return result;
+    }
+
+  const size_t second = spec.find (':', first + 1);
+  try
+    {
+      result.tolerance
+          = std::stod (spec.substr (first + 1, second - first - 1));
+      if (second != std::string::npos)
+        {
+          result.period = std::stod (spec.substr (second + 1));
+        }
+    }
+  catch (...)
+    {
+      return std::nullopt;
+    }
+
+  if (result.tolerance < 0.0 || result.period < 0.0)
+    {
+      return std::nullopt;
+    }
+  return result;
+}
+
+StateComparator::StateComparator (size_t hosts, size_t window)
+    : hosts_ (hosts), window_ (window > 0 ? window : 1), scratch_ (hosts)
+{
+  align_by (DEFAULT_ALIGNMENT);
+}
+
+bool
+StateComparator::align_by (const std::string &path, std::string *error)
+{
+  auto accessor = FieldAccessor::resolve (path, error);
+  if (!accessor)
+    {
+      return false;
+    }
+  align_ = std::move (*accessor);
+  return true;
+}
+
+bool
+StateComparator::add (const CompareSpec &spec, std::string *error)
+{
+  auto accessor = FieldAccessor::resolve (spec.path, error);
+  if (!accessor)
+    {
+      return false;
+    }
+
+  const double period
+      = spec.period > 0.0 ? spec.period : accessor->wrap_period ();
+
+  fields_.push_back (Field{ std::move (*accessor), spec.tolerance, period });
+  for (auto &values : scratch_)
+    {
+      values.resize (fields_.size ());
+    }
+  mismatches_.assign (hosts_ * fields_.size (), Mismatch{});
+  return true;
+}
+
+void
+StateComparator::set_callback (DiscrepancyCallback callback)
+{
+  callback_ = std::move (callback);
+}
+
+const std::string &
+StateComparator::alignment () const
+{
+  static const std::string none;
+  return align_ ? align_->path () : none;
+}
+
+void
+StateComparator::observe (size_t host, const ser::JonGUIState &state)
+{
+  if (host >= hosts_ || fields_.empty ())
+    {
+      return;
+    }
+
+  // Reflection reads happen outside the lock; only the copy is inside
+  const auto key
+      = align_ ? static_cast<int64_t> (std::llround (align_->get (state)))
+               : 0;
+  std::vector<double> &values = scratch_[host];
+  if (key != 0)
+    {
+      for (size_t f = 0; f < fields_.size (); ++f)
+        {
+          values[f] = fields_[f].accessor.get (state);
+        }
+    }
+
+  std::vector<Discrepancy> found;
+  {
+    std::lock_guard<std::mutex> lock (mutex_);
+    if (key == 0)
+      {
+        stats_.unaligned++;
+        return;
+      }
+    if (key <= floor_)
+      {
+        stats_.late++;
+        return;
+      }
+
+    auto it = pending_.find (key);
+    if (it == pending_.end ())
+      {
+        if (spare_.empty ())
+          {
+            it = pending_.try_emplace (key).first;
+          }
+        else
+          {
+            spare_.key () = key;
+            it = pending_.insert (std::move (spare_)).position;
+          }
+        Pending &fresh = it->second;
+        fresh.values.resize (hosts_ * fields_.size ());
+        fresh.present.assign (hosts_, false);
+        fresh.count = 0;
+        fresh.compared = false;
+      }
+
+    Pending &pending = it->second;
+    if (!pending.compared && !pending.present[host])
+      {
+        std::copy (values.begin (), values.end (),
+                   pending.values.begin ()
+                       + static_cast<std::ptrdiff_t> (host * fields_.size ()));
+        pending.present[host] = true;
+        if (++pending.count == hosts_)
+          {
+            compare (key, pending, found);
+            pending.compared = true;
+            stats_.aligned++;
+          }
+      }
+
+    // Bound the reorder buffer; retired keys stay until evicted so that
+    // later frames with the same key are not taken for new ones
+    while (pending_.size () > window_)
+      {
+        auto oldest = pending_.begin ();
+        if (!oldest->second.compared)
+          {
+            stats_.unmatched++;
+          }
+        floor_ = oldest->first;
+        spare_ = pending_.extract (oldest);
+      }
+  }
+
+  if (callback_)
+    {
+      for (const auto &discrepancy : found)
+        {
+          callback_ (discrepancy);
+        }
+    }
+}
+
+void
+StateComparator::compare (int64_t key, const Pending &pending,
+                          std::vector<Discrepancy> &found)
+{
+  const size_t n = fields_.size ();
+  for (size_t host = 1; host < hosts_; ++host)
+    {
+      for (size_t f = 0; f < n; ++f)
+        {
+          const Field &field = fields_[f];
+          const double reference = pending.values[f];
+          const double value = pending.values[host * n + f];
+          double difference = value - reference;
+          if (field.period > 0.0)
+            {
+              difference = std::remainder (difference, field.period);
+            }
+          const bool differs = std::fabs (difference) > field.tolerance;
+
+          Mismatch &mismatch = mismatches_[host * n + f];
+          if (differs)
+            {
+              stats_.mismatched++;
+              mismatch.frames++;
+              if (!mismatch.active)
+                {
+                  mismatch.active = true;
+                  mismatch.frames = 1;
+                  stats_.differing++;
+                  found.push_back (Discrepancy{ key, field.accessor.path (),
+                                                host, reference, value,
+                                                field.tolerance, false, 1 });
+                }
+            }
+          else if (mismatch.active)
+            {
+              mismatch.active = false;
+              stats_.differing--;
+              found.push_back (Discrepancy{ key, field.accessor.path (), host,
+                                            reference, value, field.tolerance,
+                                            true, mismatch.frames });
+            }
+        }
+    }
+}
+
+ComparatorStats
+StateComparator::stats () const
+{
+  std::lock_guard<std::mutex> lock (mutex_);
+  return stats_;
+}
+
+} // namespace jettison
@@ -0,0 +1,201 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 Jettison Project Team
+
+#ifndef STATE_COMPARATOR_H
+#define STATE_COMPARATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "field_accessor.h"
+#include "jon_shared_data.pb.h"
+
+namespace jettison
+{
+
+/**
+ * @brief A field compared across hosts and how far apart it may be
+ */
+struct CompareSpec
+{
+  std::string path;       // Dotted field path, e.g. "gps.latitude"
+  double tolerance = 0.0; // Largest accepted difference (0 = exact)
+  double period = 0.0;    // Wrap-around period (0 = 360 for fields
+                          // declared as one turn, e.g. [0, 360))
+};
+
+/**
+ * @brief Parse "path[:tolerance[:period]]"
+ * @param spec Compare specification
+ * @return Parsed spec, or std::nullopt if a number is malformed
+ */
+std::optional<CompareSpec> parse_compare_spec (const std::string &spec);
+
+/**
+ * @brief A field on which one host started or stopped disagreeing with
+ * the reference host (host 0)
+ */
+struct Discrepancy
+{
+  int64_t key;             // Alignment value of the frames compared
+  const std::string &path; // Field path
+  size_t host;             // Disagreeing host
+  double reference;        // Host 0's value
+  double value;            // The host's value
+  double tolerance;        // Accepted difference
+  bool cleared;            // Values agree again (reference/value are the
+                           // agreeing ones)
+  uint64_t frames;         // Frames compared while they disagreed
+};
+
+/**
+ * @brief Alignment and comparison counters
+ */
+struct ComparatorStats
+{
+  uint64_t aligned = 0;    // Keys seen from every host and compared
+  uint64_t mismatched = 0; // Field comparisons out of tolerance
+  uint64_t unmatched = 0;  // Keys dropped before every host sent them
+  uint64_t late = 0;       // Frames for keys already dropped
+  uint64_t unaligned = 0;  // Frames with an unset (zero) alignment field
+  size_t differing = 0;    // Field/host pairs currently disagreeing
+};
+
+/**
+ * @brief Compares selected fields across hosts, aligned by embedded time
+ *
+ * Each host's frames are keyed by an integer field they carry (by
+ * default actual_space_time.timestamp). Only the compared field values
+ * are kept, per key, in a bounded reorder buffer: once every host has
+ * sent a frame with a key, the first frame of each is compared against
+ * host 0 and the key is retired. When more than `window` keys are
+ * pending, the oldest is dropped and counted as unmatched, so one slow
+ * or silent host cannot make the buffer grow.
+ *
+ * Only transitions are reported: a field/host pair is reported when it
+ * goes out of tolerance and again when it agrees again, not on every
+ * frame in between. observe() is thread-safe, so hosts may be processed
+ * on different worker threads; the callback runs on the thread whose
+ * frame completed the key.
+ */
+class StateComparator
+{
+public:
+  using DiscrepancyCallback = std::function<void (const Discrepancy &)>;
+
+  static constexpr size_t DEFAULT_WINDOW = 256;
+  static constexpr const char *DEFAULT_ALIGNMENT
+      = "actual_space_time.timestamp";
+
+  /**
+   * @brief Construct a comparator
+   * @param hosts Number of hosts (at least 2)
+   * @param window Maximum number of keys pending at once
+   */
+  explicit StateComparator (size_t hosts, size_t window = DEFAULT_WINDOW);
+
+  /**
+   * @brief Set the field frames are aligned by
+   *
+   * Must be called before the first observe().
+   *
+   * @param path Dotted path of an integer field, e.g. "time.timestamp"
+   * @param error Receives the reason on failure (may be nullptr)
+   * @return false if the path does not resolve to a numeric field
+   */
+  bool align_by (const std::string &path, std::string *error = nullptr);
+
+  /**
+   * @brief Add a field to compare
+   *
+   * Must be called before the first observe().
+   *
+   * @param spec Field path and tolerance
+   * @param error Receives the reason on failure (may be nullptr)
+   * @return false if the path does not resolve to a numeric field
+   */
+  bool add (const CompareSpec &spec, std::string *error = nullptr);
+
+  /**
+   * @brief Set the callback for discrepancies
+   * @param callback Function called on every transition
+   */
+  void set_callback (DiscrepancyCallback callback);
+
+  /**
+   * @brief Feed one parsed frame from a host
+   *
+   * Frames of one host must come from one thread at a time.
+   *
+   * @param host Host index
+   * @param state Parsed state
+   */
+  void observe (size_t host, const ser::JonGUIState &state);
+
+  /**
+   * @brief Get the counters (thread-safe)
+   * @return Statistics
+   */
+  ComparatorStats stats () const;
+
+  /**
+   * @brief Get the alignment field path
+   * @return Dotted path
+   */
+  const std::string &alignment () const;
+
+  /**
+   * @brief Get the number of compared fields
+   * @return Field count
+   */
+  size_t size () const { return fields_.size (); }
+
+private:
+  struct Field
+  {
+    FieldAccessor accessor;
+    double tolerance;
+    double period;
+  };
+
+  struct Pending
+  {
+    std::vector<double> values; // hosts x fields
+    std::vector<bool> present;  // Per host
+    size_t count = 0;           // Hosts present
+    bool compared = false;      // Retired, kept to ignore later frames
+  };
+
+  struct Mismatch
+  {
+    bool active = false;
+    uint64_t frames = 0;
+  };
+
+  void compare (int64_t key, const Pending &pending,
+                std::vector<Discrepancy> &found);
+
+  size_t hosts_;
+  size_t window_;
+  std::optional<FieldAccessor> align_;
+  std::vector<Field> fields_;
+  std::vector<std::vector<double>> scratch_; // Per host, outside the lock
+  DiscrepancyCallback callback_;
+
+  mutable std::mutex mutex_;
+  std::map<int64_t, Pending> pending_;
+  std::map<int64_t, Pending>::node_type spare_; // Reused for the next key
+  std::vector<Mismatch> mismatches_; // hosts x fields
+  int64_t floor_ = INT64_MIN;        // Keys at or below were dropped
+  ComparatorStats stats_;
+};
+
+} // namespace jettison
+
+#endif // STATE_COMPARATOR_H
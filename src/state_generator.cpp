@@ -0,0 +1,403 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 Jettison Project Team
+
+#include "state_generator.h"
+#include "field_accessor.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+namespace jettison
+{
+
+using google::protobuf::FieldDescriptor;
+using google::protobuf::Message;
+
+namespace
+{
+
+/**
+ * @brief Create every singular sub-message, recursively
+ */
+void
+populate (Message &message)
+{
+  const auto *descriptor = message.GetDescriptor ();
+  const auto *reflection = message.GetReflection ();
+  for (int i = 0; i < descriptor->field_count (); ++i)
+    {
+      const auto *field = descriptor->field (i);
+      if (field->cpp_type () == FieldDescriptor::CPPTYPE_MESSAGE
+          && !field->is_repeated () && field->message_type () != descriptor)
+        {
+          populate (*reflection->MutableMessage (&message, field));
+        }
+    }
+}
+
+/**
+ * @brief Get the message holding a leaf, creating the path to it
+ */
+Message *
+mutable_parent (Message &root,
+                const std::vector<const FieldDescriptor *> &chain)
+{
+  Message *message = &root;
+  for (size_t i = 0; i + 1 < chain.size (); ++i)
+    {
+      message = message->GetReflection ()->MutableMessage (message, chain[i]);
+    }
+  return message;
+}
+
+/**
+ * @brief Check that a number is representable in a field's type
+ */
+bool
+fits (const FieldDescriptor *field, double value)
+{
+  switch (field->cpp_type ())
+    {
+    case FieldDescriptor::CPPTYPE_INT32:
+      return value >= std::numeric_limits<int32_t>::min ()
+             && value <= std::numeric_limits<int32_t>::max ();
+    case FieldDescriptor::CPPTYPE_UINT32:
+      return value >= 0.0 && value <= std::numeric_limits<uint32_t>::max ();
+    case FieldDescriptor::CPPTYPE_INT64:
+      return value >= -9.2e18 && value <= 9.2e18;
+    case FieldDescriptor::CPPTYPE_UINT64:
+      return value >= 0.0 && value <= 1.8e19;
+    case FieldDescriptor::CPPTYPE_FLOAT:
+      return std::fabs (value)
+             <= static_cast<double> (std::numeric_limits<float>::max ());
+    default:
+      return true;
+    }
+}
+
+/**
+ * @brief Store a number in a numeric leaf
+ */
+void
+set_number (Message &message, const FieldDescriptor *field, double value)
+{
+  const auto *reflection = message.GetReflection ();
+  switch (field->cpp_type ())
+    {
+    case FieldDescriptor::CPPTYPE_DOUBLE:
+      reflection->SetDouble (&message, field, value);
+      break;
+    case FieldDescriptor::CPPTYPE_FLOAT:
+      reflection->SetFloat (&message, field, static_cast<float> (value));
+      break;
+    case FieldDescriptor::CPPTYPE_INT32:
+      reflection->SetInt32 (&message, field,
+                            static_cast<int32_t> (std::llround (value)));
+      break;
+    case FieldDescriptor::CPPTYPE_INT64:
+      reflection->SetInt64 (&message, field,
+                            static_cast<int64_t> (std::llround (value)));
+      break;
+    case FieldDescriptor::CPPTYPE_UINT32:
+      reflection->SetUInt32 (&message, field,
+                             static_cast<uint32_t> (std::llround (value)));
+      break;
+    case FieldDescriptor::CPPTYPE_UINT64:
+      reflection->SetUInt64 (&message, field,
+                             static_cast<uint64_t> (std::llround (value)));
+      break;
+    default:
+      break;
+    }
+}
+
+/**
+ * @brief Uniform value inside a declared range, honouring exclusive
+ * bounds and the field's precision
+ */
+double
+value_in (const FieldAccessor::Range &range, const FieldDescriptor *field,
+          double u)
+{
+  const auto type = field->cpp_type ();
+  if (type != FieldDescriptor::CPPTYPE_DOUBLE
+      && type != FieldDescriptor::CPPTYPE_FLOAT)
+    {
+      const double low = range.min_inclusive ? std::ceil (range.min)
+                                             : std::floor (range.min) + 1.0;
+      const double high = range.max_inclusive ? std::floor (range.max)
+                                              : std::ceil (range.max) - 1.0;
+      return high < low ? low : low + std::floor (u * (high - low + 1.0));
+    }
+
+  double value = range.min + u * (range.max - range.min);
+  if (type == FieldDescriptor::CPPTYPE_FLOAT)
+    {
+      value = static_cast<double> (static_cast<float> (value));
+    }
+  if (value > range.max || (!range.max_inclusive && value >= range.max))
+    {
+      value = std::nextafter (range.max, range.min);
+    }
+  if (value < range.min || (!range.min_inclusive && value <= range.min))
+    {
+      value = std::nextafter (range.min, range.max);
+    }
+  return value;
+}
+
+/**
+ * @brief Read a base-128 varint, advancing p
+ */
+bool
+skip_varint (const uint8_t *&p, const uint8_t *end, uint64_t &value)
+{
+  value = 0;
+  for (unsigned shift = 0; shift < 64 && p < end; shift += 7)
+    {
+      const uint8_t byte = *p++;
+      value |= static_cast<uint64_t> (byte & 0x7F) << shift;
+      if ((byte & 0x80) == 0)
+        {
+          return true;
+        }
+    }
+  return false;
+}
+
+/**
+ * @brief Offsets of the top-level tags of a serialized message
+ */
+std::vector<uint32_t>
+top_level_tags (const std::vector<uint8_t> &payload)
+{
+  std::vector<uint32_t> offsets;
+  const uint8_t *p = payload.data ();
+  const uint8_t *const end = p + payload.size ();
+  while (p < end)
+    {
+      offsets.push_back (static_cast<uint32_t> (p - payload.data ()));
+      uint64_t tag = 0;
+      uint64_t value = 0;
+      if (!skip_varint (p, end, tag))
+        {
+          break;
+        }
+      const auto remaining = static_cast<uint64_t> (end - p);
+      switch (tag & 7)
+        {
+        case 0:
+          skip_varint (p, end, value);
+          break;
+        case 1:
+          p += std::min<uint64_t> (8, remaining);
+          break;
+        case 2:
+          skip_varint (p, end, value);
+          p += std::min<uint64_t> (value, static_cast<uint64_t> (end - p));
+          break;
+        case 5:
+          p += std::min<uint64_t> (4, remaining);
+          break;
+        default:
+          p = end;
+          break;
+        }
+    }
+  return offsets;
+}
+
+std::vector<uint8_t>
+serialize (const ser::JonGUIState &state)
+{
+  std::vector<uint8_t> bytes (state.ByteSizeLong ());
+  state.SerializeToArray (bytes.data (), static_cast<int> (bytes.size ()));
+  return bytes;
+}
+
+} // namespace
+
+const char *
+corruption_name (Corruption corruption)
+{
+  switch (corruption)
+    {
+    case Corruption::OutOfRange:
+      return "out-of-range";
+    case Corruption::Missing:
+      return "missing";
+    case Corruption::Truncated:
+      return "truncated";
+    case Corruption::BadTag:
+      return "bad-tag";
+    case Corruption::None:
+    default:
+      return "valid";
+    }
+}
+
+StateGenerator::StateGenerator (Mix mix, uint64_t seed,
+                                const ser::JonGUIState *base,
+                                size_t pool_size)
+    : mix_ (mix), rng_ (seed)
+{
+  if (base != nullptr)
+    {
+      base_ = *base;
+    }
+  else
+    {
+      populate (base_);
+      base_.set_protocol_version (1);
+    }
+
+  // Ranged leaves can be corrupted; top-level sub-messages can go missing
+  std::vector<std::pair<FieldAccessor, FieldAccessor::Range>> ranged;
+  for (auto &field : FieldAccessor::numeric_leaves ())
+    {
+      if (const auto range = field.declared_range ())
+        {
+          ranged.emplace_back (std::move (field), *range);
+        }
+    }
+  std::vector<const FieldDescriptor *> sections;
+  const auto *root = ser::JonGUIState::descriptor ();
+  for (int i = 0; i < root->field_count (); ++i)
+    {
+      const auto *field = root->field (i);
+      if (field->cpp_type () == FieldDescriptor::CPPTYPE_MESSAGE
+          && !field->is_repeated ()
+          && base_.GetReflection ()->HasField (base_, field))
+        {
+          sections.push_back (field);
+        }
+    }
+
+  std::uniform_real_distribution<double> unit (0.0, 1.0);
+  pool_.reserve (pool_size);
+  for (size_t i = 0; i < pool_size; ++i)
+    {
+      ser::JonGUIState state = base_;
+      randomize (state);
+
+      Entry entry;
+      entry.valid = serialize (state);
+      entry.tag_offsets = top_level_tags (entry.valid);
+
+      ser::JonGUIState damaged = state;
+      if (!ranged.empty ())
+        {
+          const auto &[field, range] = ranged[rng_ () % ranged.size ()];
+          const auto *leaf = field.chain ().back ();
+          const double overshoot = (range.max - range.min) * (0.5 + unit (rng_))
+                                   + 1.0;
+          double value = (rng_ () & 1) != 0 ? range.max + overshoot
+                                            : range.min - overshoot;
+          if (!fits (leaf, value))
+            {
+              value = value > range.max ? range.min - overshoot
+                                        : range.max + overshoot;
+            }
+          set_number (*mutable_parent (damaged, field.chain ()), leaf, value);
+        }
+      entry.out_of_range = serialize (damaged);
+
+      damaged = state;
+      if (!sections.empty ())
+        {
+          damaged.GetReflection ()->ClearField (
+              &damaged, sections[rng_ () % sections.size ()]);
+        }
+      entry.missing = serialize (damaged);
+
+      pool_.push_back (std::move (entry));
+    }
+}
+
+void
+StateGenerator::randomize (ser::JonGUIState &state)
+{
+  static const auto leaves = FieldAccessor::numeric_leaves ();
+  std::uniform_real_distribution<double> unit (0.0, 1.0);
+
+  for (const auto &field : leaves)
+    {
+      const auto *leaf = field.chain ().back ();
+      if (leaf->cpp_type () == FieldDescriptor::CPPTYPE_BOOL)
+        {
+          Message *parent = mutable_parent (state, field.chain ());
+          parent->GetReflection ()->SetBool (parent, leaf, (rng_ () & 1) != 0);
+          continue;
+        }
+      if (const auto range = field.declared_range ())
+        {
+          set_number (*mutable_parent (state, field.chain ()), leaf,
+                      value_in (*range, leaf, unit (rng_)));
+        }
+    }
+}
+
+Corruption
+StateGenerator::pick ()
+{
+  double u = std::uniform_real_distribution<double> (0.0, 1.0) (rng_);
+  if ((u -= mix_.out_of_range) < 0.0)
+    {
+      return Corruption::OutOfRange;
+    }
+  if ((u -= mix_.missing) < 0.0)
+    {
+      return Corruption::Missing;
+    }
+  if ((u -= mix_.truncated) < 0.0)
+    {
+      return Corruption::Truncated;
+    }
+  if ((u -= mix_.bad_tag) < 0.0)
+    {
+      return Corruption::BadTag;
+    }
+  return Corruption::None;
+}
+
+Corruption
+StateGenerator::next (std::vector<uint8_t> &payload)
+{
+  const Entry &entry = pool_[rng_ () % pool_.size ()];
+  const Corruption corruption = pick ();
+
+  switch (corruption)
+    {
+    case Corruption::OutOfRange:
+      payload.assign (entry.out_of_range.begin (), entry.out_of_range.end ());
+      break;
+    case Corruption::Missing:
+      payload.assign (entry.missing.begin (), entry.missing.end ());
+      break;
+    case Corruption::Truncated:
+      payload.assign (entry.valid.begin (), entry.valid.end ());
+      if (payload.size () > 1)
+        {
+          payload.resize (1 + rng_ () % (payload.size () - 1));
+        }
+      break;
+    case Corruption::BadTag:
+      payload.assign (entry.valid.begin (), entry.valid.end ());
+      if (!entry.tag_offsets.empty ())
+        {
+          // Field number 0 with wire type 7 is never a valid tag
+          payload[entry.tag_offsets[rng_ () % entry.tag_offsets.size ()]]
+              = 0x07;
+        }
+      break;
+    case Corruption::None:
+    default:
+      payload.assign (entry.valid.begin (), entry.valid.end ());
+      break;
+    }
+
+  return corruption;
+}
+
+} // namespace jettison
@@ -0,0 +1,110 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 Jettison Project Team
+
+#ifndef STATE_GENERATOR_H
+#define STATE_GENERATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "jon_shared_data.pb.h"
+
+namespace jettison
+{
+
+/**
+ * @brief Kind of damage applied to a generated payload
+ */
+enum class Corruption : uint8_t
+{
+  None,       // Schema-valid message
+  OutOfRange, // One ranged field set outside its buf.validate range
+  Missing,    // One top-level sub-message removed
+  Truncated,  // Payload cut short at a random byte (may still parse
+              // when cut at a field boundary)
+  BadTag      // One top-level tag replaced by an invalid one
+};
+
+/**
+ * @brief Get a short name for a corruption kind
+ * @param corruption Kind
+ * @return e.g. "out-of-range"
+ */
+const char *corruption_name (Corruption corruption);
+
+/**
+ * @brief Randomized JonGUIState payloads with controlled corruption
+ *
+ * At construction a pool of messages is built from a base message: every
+ * numeric field with a closed buf.validate range gets a uniform random
+ * value inside it, bools are randomized, and everything else keeps the
+ * base value. Each pool entry also has an out-of-range and a
+ * missing-sub-message variant. next() then only copies a pooled payload
+ * and, for Truncated and BadTag, damages the copy, so it produces
+ * millions of frames per second for throughput tests.
+ *
+ * Messages are only as valid as the base: fields without a closed range
+ * keep its values, so pass a captured dump for a fully valid template.
+ * Not thread-safe; use one generator per thread.
+ */
+class StateGenerator
+{
+public:
+  /**
+   * @brief Fraction of frames per corruption kind (the rest are valid)
+   */
+  struct Mix
+  {
+    double out_of_range = 0.0;
+    double missing = 0.0;
+    double truncated = 0.0;
+    double bad_tag = 0.0;
+  };
+
+  /**
+   * @brief Build the payload pool
+   * @param mix Corruption fractions (should sum to at most 1)
+   * @param seed Random seed (same seed, same sequence)
+   * @param base Template message (nullptr = every sub-message present
+   *             with default values and protocol_version 1)
+   * @param pool_size Number of distinct messages generated up front
+   */
+  StateGenerator (Mix mix, uint64_t seed,
+                  const ser::JonGUIState *base = nullptr,
+                  size_t pool_size = 1024);
+
+  /**
+   * @brief Produce the next payload
+   * @param payload Receives the serialized (possibly damaged) message
+   * @return Corruption applied
+   */
+  Corruption next (std::vector<uint8_t> &payload);
+
+  /**
+   * @brief Fill a message with random schema-valid values
+   * @param state Message to overwrite (starts as a copy of the base)
+   */
+  void randomize (ser::JonGUIState &state);
+
+private:
+  struct Entry
+  {
+    std::vector<uint8_t> valid;
+    std::vector<uint8_t> out_of_range;
+    std::vector<uint8_t> missing;
+    std::vector<uint32_t> tag_offsets; // Top-level tags in valid
+  };
+
+  Corruption pick ();
+
+  Mix mix_;
+  std::mt19937_64 rng_;
+  ser::JonGUIState base_;
+  std::vector<Entry> pool_;
+};
+
+} // namespace jettison
+
+#endif // STATE_GENERATOR_H
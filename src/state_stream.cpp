@@ -0,0 +1,86 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 Jettison Project Team
+
+#include "state_stream.h"
+#include <utility>
+
+namespace jettison
+{
+
+bool
+StateStream::NextState::await_ready () const noexcept
+{
+  return stream_.is_cancelled ();
+}
+
+void
+StateStream::NextState::await_suspend (std::coroutine_handle<> handle) noexcept
+{
+  stream_.waiter_ = handle;
+}
+
+const StateEvent *
+StateStream::NextState::await_resume () noexcept
+{
+  return std::exchange (stream_.current_, nullptr);
+}
+
+StateStream::StateStream (Receiver &receiver, std::stop_token stop)
+    : receiver_ (receiver)
+{
+  receiver_.subscribe ([this] (const StateEvent &event) { push (event); });
+  if (stop.stop_possible ())
+    {
+      stop_callback_.emplace (std::move (stop), StopForwarder{ this });
+    }
+}
+
+void
+StateStream::push (const StateEvent &event)
+{
+  if (!waiter_ || is_cancelled ())
+    {
+      skipped_++;
+      return;
+    }
+
+  // Resume inline; the coroutine runs until it awaits again
+  current_ = &event;
+  std::exchange (waiter_, {}).resume ();
+  current_ = nullptr;
+}
+
+void
+StateStream::cancel ()
+{
+  if (cancelled_.exchange (true))
+    {
+      return;
+    }
+  // The waiter belongs to the event loop thread, so resume it there
+  receiver_.post ([this] () { resume_cancelled (); });
+}
+
+void
+StateStream::close ()
+{
+  cancelled_ = true;
+  resume_cancelled ();
+}
+
+bool
+StateStream::is_cancelled () const
+{
+  return cancelled_.load (std::memory_order_acquire);
+}
+
+void
+StateStream::resume_cancelled ()
+{
+  if (waiter_)
+    {
+      std::exchange (waiter_, {}).resume ();
+    }
+}
+
+} // namespace jettison
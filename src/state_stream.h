@@ -0,0 +1,146 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 Jettison Project Team
+
+#ifndef STATE_STREAM_H
+#define STATE_STREAM_H
+
+#include <atomic>
+#include <coroutine>
+#include <cstdint>
+#include <optional>
+#include <stop_token>
+
+#include "receiver.h"
+
+namespace jettison
+{
+
+/**
+ * @brief Awaitable stream of validated states for C++20 coroutines
+ *
+ * Subscribes to a Receiver and lets a coroutine pull frames with
+ * `co_await stream.next_state ()`. A suspended consumer is resumed inline
+ * from the subscriber callback, on the event loop thread, so there is no
+ * queue and no thread hop: the returned StateEvent is the receiver's own,
+ * valid until the coroutine next suspends.
+ *
+ * Frames arriving while no coroutine is waiting are skipped and counted
+ * (latest-value semantics). Use with ReceiverOptions::workers = 0, so that
+ * frames and cancellation are both delivered on the event loop thread.
+ *
+ * @code
+ *   Task consume (StateStream &stream)
+ *   {
+ *     while (const StateEvent *event = co_await stream.next_state ())
+ *       {
+ *         handle (*event);
+ *       }
+ *     // cancelled
+ *   }
+ * @endcode
+ */
+class StateStream
+{
+public:
+  /**
+   * @brief Awaiter returned by next_state()
+   *
+   * Resumes with the next frame, or nullptr once the stream is cancelled.
+   */
+  class NextState
+  {
+  public:
+    explicit NextState (StateStream &stream) : stream_ (stream) {}
+
+    bool await_ready () const noexcept;
+    void await_suspend (std::coroutine_handle<> handle) noexcept;
+    const StateEvent *await_resume () noexcept;
+
+  private:
+    StateStream &stream_;
+  };
+
+  /**
+   * @brief Subscribe to a receiver
+   *
+   * Must be constructed before receiver.start(), and must outlive
+   * receiver.run().
+   *
+   * @param receiver Receiver to subscribe to
+   * @param stop Optional stop token; a stop request cancels the stream
+   */
+  explicit StateStream (Receiver &receiver, std::stop_token stop = {});
+
+  // Non-copyable, non-movable (the receiver holds a pointer to it)
+  StateStream (const StateStream &) = delete;
+  StateStream &operator= (const StateStream &) = delete;
+  StateStream (StateStream &&) = delete;
+  StateStream &operator= (StateStream &&) = delete;
+
+  /**
+   * @brief Await the next frame
+   * @return Awaitable yielding const StateEvent*, nullptr when cancelled
+   */
+  NextState next_state () { return NextState (*this); }
+
+  /**
+   * @brief Cancel the stream (thread-safe)
+   *
+   * A waiting coroutine is resumed on the event loop thread with nullptr;
+   * later next_state() calls complete immediately with nullptr.
+   */
+  void cancel ();
+
+  /**
+   * @brief Cancel the stream and resume a waiting coroutine immediately
+   *
+   * Same as cancel(), but resumes inline. Call from the event loop thread,
+   * or after receiver.run() returned.
+   */
+  void close ();
+
+  /**
+   * @brief Deliver one frame to the waiting coroutine, if any
+   *
+   * Called by the receiver subscription; public so that other event
+   * sources can drive the stream. Call from the event loop thread.
+   *
+   * @param event Frame to deliver
+   */
+  void push (const StateEvent &event);
+
+  /**
+   * @brief Check whether the stream was cancelled
+   * @return true after cancel() or a stop request
+   */
+  bool is_cancelled () const;
+
+  /**
+   * @brief Get the number of frames that arrived with no coroutine waiting
+   * @return Skipped frame count
+   */
+  uint64_t skipped_count () const { return skipped_; }
+
+private:
+  void resume_cancelled ();
+
+  /**
+   * @brief Stop callback that forwards to cancel()
+   */
+  struct StopForwarder
+  {
+    StateStream *stream;
+    void operator() () const noexcept { stream->cancel (); }
+  };
+
+  Receiver &receiver_;
+  std::coroutine_handle<> waiter_;
+  const StateEvent *current_ = nullptr;
+  std::atomic<bool> cancelled_{ false };
+  uint64_t skipped_ = 0;
+  std::optional<std::stop_callback<StopForwarder>> stop_callback_;
+};
+
+} // namespace jettison
+
+#endif // STATE_STREAM_H
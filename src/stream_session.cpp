@@ -0,0 +1,994 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 Jettison Project Team
+
+#include "stream_session.h"
+#include "columnar_writer.h"
+#include "dedup_store.h"
+#include "dump_manager.h"
+#include "json_converter.h"
+#include "logger.h"
+#include "output_throttle.h"
+#include "shm_state.h"
+#include "state_generator.h"
+#include "violation_aggregator.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+
+#include <sys/resource.h>
+
+namespace jettison
+{
+
+namespace
+{
+
+constexpr std::chrono::milliseconds VIOLATION_POLL_INTERVAL{ 250 };
+
+/**
+ * @brief Per-host output state and counters
+ *
+ * Only touched by the thread that processes the host's frames (the
+ * event loop, or the worker owning the host's shard).
+ */
+struct HostState
+{
+  std::string tag; // Output prefix, empty when streaming a single host
+  OutputThrottle throttle;
+  FieldWatcher watcher; // Replaces per-frame output when non-empty
+  std::unique_ptr<ViolationAggregator> violations; // Null = print all
+  uint64_t messages = 0;
+  uint64_t bytes = 0;
+  uint64_t valid = 0;
+  uint64_t invalid = 0;
+  uint64_t parse_errors = 0;
+};
+
+/**
+ * @brief Print ViolationAggregator summary lines for one host
+ */
+void
+print_violation_summaries (const std::string &tag,
+                           const std::vector<std::string> &lines)
+{
+  if (lines.empty ())
+    {
+      return;
+    }
+
+  for (const auto &line : lines)
+    {
+      log_info (tag, "Violations: ", line);
+    }
+}
+
+/**
+ * @brief Print the violation summaries of one host that are due
+ */
+void
+poll_violations (HostState &host)
+{
+  std::vector<std::string> lines;
+  host.violations->poll (ViolationAggregator::Clock::now (), lines);
+  print_violation_summaries (host.tag, lines);
+}
+
+/**
+ * @brief Format a state payload as JSON (a LogArg::deferred formatter)
+ */
+void
+format_state_json (std::string_view payload, std::string &line)
+{
+  // Called on the logger thread (on the caller's while it is stopped)
+  static thread_local ser::JonGUIState state;
+  static thread_local JsonConverter json_converter;
+  if (state.ParseFromArray (payload.data (),
+                            static_cast<int> (payload.size ())))
+    {
+      line += json_converter.to_json (state, true);
+    }
+}
+
+/**
+ * @brief Count one validated frame and print its report if due
+ */
+void
+report_frame (HostState &host, const StateEvent &event)
+{
+  host.messages++;
+  host.bytes += event.payload_len;
+
+  // Every frame was parsed and validated, even those not printed
+  const bool parsed = event.state != nullptr;
+  const auto &result = event.validation;
+  const bool failed = !parsed || !result.is_valid;
+  bool notable = failed || !result.warnings.empty ();
+
+  if (!parsed)
+    {
+      host.parse_errors++;
+    }
+  else if (result.is_valid)
+    {
+      host.valid++;
+    }
+  else
+    {
+      host.invalid++;
+    }
+
+  // Repeated violations are counted and summarized; only frames bringing
+  // a new one are printed. A failure with nothing new is left to the
+  // periodic summary before anything is formatted, whatever the throttle
+  // allows.
+  if (host.violations)
+    {
+      const bool new_errors
+          = host.violations->add (result.errors, event.received_at);
+      const bool new_warnings
+          = host.violations->add (result.warnings, event.received_at);
+      notable = new_errors || new_warnings;
+      if (failed && !notable)
+        {
+          return;
+        }
+    }
+
+  // In watch mode valid frames only report qualifying field changes
+  if (!failed && host.watcher.size () > 0)
+    {
+      host.watcher.update (*event.state);
+      if (!notable)
+        {
+          return;
+        }
+    }
+
+  // Valid frames are rate-controlled; new violations are always reported
+  if (!notable && !host.throttle.should_emit (event.received_at))
+    {
+      return;
+    }
+
+  const std::string &tag = host.tag;
+  if (!parsed)
+    {
+      log_info ("\n=== ", tag, "Message #", event.sequence,
+                " (size: ", event.payload_len, " bytes) ===");
+      std::ostringstream err;
+      err << tag << "INVALID MESSAGE\n";
+      err << tag << "Parse errors:\n";
+      for (const auto &error : result.errors)
+        {
+          err << tag << "  - " << error << "\n";
+        }
+      log_lines (LogLevel::Error, err.str ());
+      return;
+    }
+
+  // Only violation lines are formatted here; the rest of the report, and
+  // the JSON converted from the payload, is formatted by the logger
+  std::string details;
+  if (!result.is_valid || !result.warnings.empty ())
+    {
+      std::ostringstream out;
+      for (const auto &error : result.errors)
+        {
+          out << tag << "  Error: " << error << "\n";
+        }
+      if (!result.warnings.empty ())
+        {
+          out << tag << "Warnings:\n";
+          for (const auto &warning : result.warnings)
+            {
+              out << tag << "  - " << warning << "\n";
+            }
+        }
+      details = out.str ();
+    }
+
+  log_info ("\n=== ", tag, "Message #", event.sequence,
+            " (size: ", event.payload_len, " bytes) ===\n", tag,
+            result.is_valid ? "Validation: PASSED\n" : "Validation: FAILED\n",
+            details, "\n", tag, "JSON Output:\n",
+            LogArg::deferred (
+                std::string_view (
+                    reinterpret_cast<const char *> (event.payload),
+                    event.payload_len),
+                format_state_json));
+}
+
+/**
+ * @brief Print permessage-deflate bandwidth/CPU accounting for one host
+ */
+void
+print_deflate_stats (const std::string &tag, const ConnectionStats &stats)
+{
+  if (!stats.deflate_offered)
+    {
+      log_info ("  ", tag,
+                "deflate: not offered (libwebsockets built without "
+                "extensions)");
+      return;
+    }
+  if (!stats.deflate_negotiated)
+    {
+      log_info ("  ", tag, "deflate: offered, not accepted by server");
+      return;
+    }
+
+  const double messages = static_cast<double> (
+      std::max<uint64_t> (stats.compressed_messages, 1));
+  const double ratio
+      = stats.inflate_in_bytes > 0
+            ? static_cast<double> (stats.inflate_out_bytes)
+                  / static_cast<double> (stats.inflate_in_bytes)
+            : 0.0;
+
+  std::ostringstream line;
+  line.setf (std::ios::fixed);
+  line.precision (1);
+  line << "  " << tag << "deflate: " << stats.compressed_messages << "/"
+       << stats.messages << " messages compressed, "
+       << static_cast<double> (stats.inflate_in_bytes) / messages
+       << " B/msg on wire -> "
+       << static_cast<double> (stats.inflate_out_bytes) / messages
+       << " B/msg (x" << ratio << "), inflate CPU "
+       << stats.inflate_cpu_ms * 1000.0 / messages << " us/msg\n";
+  log_lines (LogLevel::Info, line.str ());
+}
+
+/**
+ * @brief Print gap/duplicate/reorder counters for a single host
+ */
+void
+print_sequence_stats (const SequenceStats &stats, bool skipped_duplicates)
+{
+  if (stats.gaps == 0 && stats.duplicates == 0 && stats.out_of_order == 0
+      && stats.restarts == 0)
+    {
+      return;
+    }
+
+  std::string restarts;
+  if (stats.restarts > 0)
+    {
+      restarts = ", " + std::to_string (stats.restarts) + " device restarts";
+    }
+  log_info ("Sequence: ", stats.gaps, " gaps (~", stats.missing,
+            " frames missing), ", stats.duplicates, " duplicates",
+            skipped_duplicates ? " (skipped)" : "", ", ", stats.out_of_order,
+            " out of order", restarts);
+}
+
+/**
+ * @brief Print frame latency percentiles and page faults while streaming
+ */
+void
+print_latency (const LatencyHistogram &latency, long minor_faults,
+               long major_faults)
+{
+  if (latency.count () == 0)
+    {
+      return;
+    }
+
+  const auto us = [] (uint64_t ns) { return static_cast<double> (ns) / 1e3; };
+  std::ostringstream line;
+  line.setf (std::ios::fixed);
+  line.precision (1);
+  line << "Latency (receive -> delivered): p50 " << us (latency.percentile (0.5))
+       << " us, p99 " << us (latency.percentile (0.99)) << " us, p99.9 "
+       << us (latency.percentile (0.999)) << " us, max " << us (latency.max ())
+       << " us (" << latency.count () << " frames)\n";
+  line << "Page faults while streaming: " << minor_faults << " minor, "
+       << major_faults << " major\n";
+  log_lines (LogLevel::Info, line.str ());
+}
+
+/**
+ * @brief Insert ".N" before a file's extension, e.g. out.csv -> out.1.csv
+ */
+std::string
+indexed_file_name (const std::string &filename, size_t index)
+{
+  const size_t dot = filename.rfind ('.');
+  const size_t slash = filename.rfind ('/');
+  const std::string suffix = "." + std::to_string (index);
+  if (dot == std::string::npos
+      || (slash != std::string::npos && dot < slash))
+    {
+      return filename + suffix;
+    }
+  return filename.substr (0, dot) + suffix + filename.substr (dot);
+}
+
+/**
+ * @brief Receiver options with a sample frame for realtime pre-faulting
+ *
+ * A generated frame sets every field, so parsing it grows the receiver's
+ * messages to the largest state the server sends.
+ */
+ReceiverOptions
+receiver_options (const ReceiverOptions &options)
+{
+  ReceiverOptions result = options;
+  if (result.realtime.enabled && result.sample_frame.empty ())
+    {
+      StateGenerator (StateGenerator::Mix{}, 1, nullptr, 1)
+          .next (result.sample_frame);
+    }
+  return result;
+}
+
+int64_t
+unix_time_ns ()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds> (
+             std::chrono::system_clock::now ().time_since_epoch ())
+      .count ();
+}
+
+} // namespace
+
+class StreamSession::Impl
+{
+public:
+  explicit Impl (StreamOptions options)
+      : options_ (std::move (options)),
+        receiver_ (receiver_options (options_.receiver))
+  {
+  }
+
+  bool open ();
+  bool run ();
+  void finish ();
+
+  Receiver &receiver () { return receiver_; }
+  const std::vector<std::unique_ptr<HistoryStore>> &
+  history () const
+  {
+    return stores_;
+  }
+
+private:
+  bool open_hosts ();
+  bool open_outputs ();
+  bool open_comparator ();
+  void add_sinks ();
+  SinkOptions sink_options (const std::string &name, size_t capacity,
+                            OverflowPolicy overflow, SinkInput input,
+                            bool needs_state) const;
+  void process (const StateEvent &event);
+
+  const StreamOptions options_;
+  const bool multi_host_ = options_.receiver.endpoints.size () > 1;
+  Receiver receiver_;
+  std::vector<HostState> hosts_;
+  uint64_t received_count_ = 0; // Only touched by the event loop
+  long minor_faults_ = 0;       // While streaming
+  long major_faults_ = 0;
+
+  std::vector<std::unique_ptr<ShmPublisher>> publishers_;
+  std::vector<std::unique_ptr<ColumnarWriter>> recorders_;
+  std::vector<std::unique_ptr<HistoryStore>> stores_;
+  std::vector<std::unique_ptr<DedupWriter>> captures_;
+  std::unique_ptr<StateComparator> comparator_;
+  std::ofstream ndjson_;
+  JsonConverter ndjson_converter_;
+  DumpManager dump_manager_;
+  int saved_count_ = 0; // Only touched by the dump sink
+
+  // Last, so the sinks stop before what they write to is destroyed
+  SinkGraph sinks_;
+};
+
+bool
+StreamSession::Impl::open ()
+{
+  if (!open_hosts () || !open_outputs () || !open_comparator ())
+    {
+      return false;
+    }
+  add_sinks ();
+
+  receiver_.set_connection_callback ([this] (size_t target, bool connected) {
+    log_info (hosts_[target].tag,
+              connected ? "Connected successfully" : "Disconnected");
+  });
+
+  receiver_.set_error_callback (
+      [this] (size_t target, const std::string &error) {
+        log_error (target < hosts_.size () ? hosts_[target].tag : "",
+                   "Error: ", error);
+      });
+
+  receiver_.set_status_callback (
+      [this] (size_t target, const std::string &message) {
+        log_info (hosts_[target].tag, message);
+      });
+
+  // Raw payloads arrive on the event loop, before validation
+  receiver_.set_raw_callback (
+      [this] (size_t, const uint8_t *, size_t) { received_count_++; });
+
+  receiver_.subscribe ([this] (const StateEvent &event) { process (event); });
+
+  // Outputs get the frame last, taking over the receiver's buffers; only
+  // a blocking queue (the dump's, or one set in sink_queues) can wait here
+  if (sinks_.size () > 0)
+    {
+      receiver_.set_handoff_callback (
+          [this] (const StateEvent &event, FrameBuffers &buffers) {
+            sinks_.publish (event, buffers);
+          });
+    }
+
+  // Summaries and clear notices are due even when frames stop arriving
+  if (options_.violation_window > 0.0)
+    {
+      receiver_.set_tick_callback (VIOLATION_POLL_INTERVAL,
+                                   [this] (size_t target) {
+                                     poll_violations (hosts_[target]);
+                                   });
+    }
+  return true;
+}
+
+bool
+StreamSession::Impl::open_hosts ()
+{
+  for (const auto &endpoint : options_.receiver.endpoints)
+    {
+      log_info ("Connecting to ", endpoint.to_uri ());
+
+      HostState host;
+      host.throttle = OutputThrottle (options_.max_hz, options_.every_k);
+      if (options_.violation_window > 0.0)
+        {
+          ViolationAggregator::Config config;
+          config.window = std::chrono::duration_cast<
+              ViolationAggregator::Clock::duration> (
+              std::chrono::duration<double> (options_.violation_window));
+          host.violations = std::make_unique<ViolationAggregator> (config);
+        }
+      if (multi_host_)
+        {
+          host.tag = "[" + endpoint.host + ":"
+                     + std::to_string (endpoint.port) + "] ";
+        }
+      hosts_.push_back (std::move (host));
+    }
+
+  // The callbacks keep a reference to their host, so hosts_ is complete
+  for (auto &host : hosts_)
+    {
+      for (const auto &spec : options_.watches)
+        {
+          std::string error;
+          if (!host.watcher.add (spec, &error))
+            {
+              log_error ("Error: --watch ", spec.path, ": ", error);
+              return false;
+            }
+        }
+      host.watcher.set_callback ([&host] (const FieldChange &change) {
+        if (change.initial)
+          {
+            log_info (host.tag, change.path, ": ", change.current,
+                      " (message #", host.messages, ")");
+          }
+        else
+          {
+            log_info (host.tag, change.path, ": ", change.previous, " -> ",
+                      change.current, " (message #", host.messages, ")");
+          }
+      });
+    }
+  if (options_.receiver.workers > 0)
+    {
+      log_info ("Validating on ", options_.receiver.workers,
+                " worker threads");
+    }
+  return true;
+}
+
+bool
+StreamSession::Impl::open_outputs ()
+{
+  const size_t targets = options_.receiver.endpoints.size ();
+
+  // One shared-memory region per host; name.N when streaming several
+  if (!options_.shm_name.empty ())
+    {
+      for (size_t i = 0; i < targets; ++i)
+        {
+          std::string name = options_.shm_name;
+          if (multi_host_)
+            {
+              name += "." + std::to_string (i);
+            }
+          auto publisher = std::make_unique<ShmPublisher> (name);
+          if (!publisher->is_open ())
+            {
+              return false;
+            }
+          log_info ("Publishing latest valid state to shared memory ", name);
+          publishers_.push_back (std::move (publisher));
+        }
+    }
+
+  // One recording per host; file.N.ext when streaming several
+  if (!options_.record_file.empty ())
+    {
+      for (size_t i = 0; i < targets; ++i)
+        {
+          const std::string name
+              = multi_host_ ? indexed_file_name (options_.record_file, i)
+                            : options_.record_file;
+          auto recorder = std::make_unique<ColumnarWriter> ();
+          if (!recorder->open (name, ColumnarWriter::format_for (name)))
+            {
+              return false;
+            }
+          log_info ("Recording ", recorder->column_count (), " columns to ",
+                    name);
+          recorders_.push_back (std::move (recorder));
+        }
+    }
+
+  // One history store per host
+  if (!options_.history_fields.empty ())
+    {
+      std::vector<FieldAccessor> fields;
+      for (const auto &path : options_.history_fields)
+        {
+          std::string error;
+          auto accessor = FieldAccessor::resolve (path, &error);
+          if (!accessor)
+            {
+              log_error ("Error: --history ", path, ": ", error);
+              return false;
+            }
+          fields.push_back (std::move (*accessor));
+        }
+      for (size_t i = 0; i < targets; ++i)
+        {
+          stores_.push_back (std::make_unique<HistoryStore> (fields));
+        }
+      log_info ("Keeping history of ", fields.size (), " fields (",
+                stores_[0]->memory_bytes () / 1024, " KiB per host)");
+    }
+
+  // One raw capture per host; file.N.ext when streaming several
+  if (!options_.capture_file.empty ())
+    {
+      for (size_t i = 0; i < targets; ++i)
+        {
+          const std::string name
+              = multi_host_ ? indexed_file_name (options_.capture_file, i)
+                            : options_.capture_file;
+          auto capture = std::make_unique<DedupWriter> ();
+          if (!capture->open (name))
+            {
+              return false;
+            }
+          log_info ("Capturing raw payloads to ", name);
+          captures_.push_back (std::move (capture));
+        }
+    }
+
+  // One JSON object per line for a local consumer (a file or a FIFO)
+  if (!options_.ndjson_file.empty ())
+    {
+      ndjson_.open (options_.ndjson_file, std::ios::out | std::ios::trunc);
+      if (!ndjson_.is_open ())
+        {
+          log_error ("Error: failed to open ", options_.ndjson_file);
+          return false;
+        }
+      log_info ("Streaming JSON lines to ", options_.ndjson_file);
+    }
+  return true;
+}
+
+bool
+StreamSession::Impl::open_comparator ()
+{
+  if (options_.compares.empty ())
+    {
+      return true;
+    }
+
+  // Cross-host comparison, aligned by a time field every host embeds
+  comparator_ = std::make_unique<StateComparator> (hosts_.size ());
+  std::string error;
+  if (!options_.align_by.empty ()
+      && !comparator_->align_by (options_.align_by, &error))
+    {
+      log_error ("Error: --align-by ", options_.align_by, ": ", error);
+      return false;
+    }
+  for (const auto &spec : options_.compares)
+    {
+      if (!comparator_->add (spec, &error))
+        {
+          log_error ("Error: --compare ", spec.path, ": ", error);
+          return false;
+        }
+    }
+  comparator_->set_callback ([this] (const Discrepancy &discrepancy) {
+    const std::string &tag = hosts_[discrepancy.host].tag;
+    if (discrepancy.cleared)
+      {
+        log_info (tag, discrepancy.path, " agrees with ", hosts_[0].tag,
+                  "again at ", discrepancy.key, " after ",
+                  discrepancy.frames, " frames: ", discrepancy.value);
+      }
+    else
+      {
+        log_info (tag, discrepancy.path, " differs from ", hosts_[0].tag,
+                  "at ", discrepancy.key, ": ", discrepancy.value, " vs ",
+                  discrepancy.reference, " (tolerance ",
+                  discrepancy.tolerance, ")");
+      }
+  });
+  log_info ("Comparing ", comparator_->size (),
+            " fields across hosts, aligned by ", comparator_->alignment ());
+  return true;
+}
+
+SinkOptions
+StreamSession::Impl::sink_options (const std::string &name, size_t capacity,
+                                   OverflowPolicy overflow, SinkInput input,
+                                   bool needs_state) const
+{
+  SinkOptions result;
+  result.capacity = capacity;
+  result.overflow = overflow;
+  result.input = input;
+  result.needs_state = needs_state;
+  const auto it = options_.sink_queues.find (name);
+  if (it != options_.sink_queues.end ())
+    {
+      if (it->second.capacity > 0)
+        {
+          result.capacity = it->second.capacity;
+        }
+      if (it->second.overflow)
+        {
+          result.overflow = *it->second.overflow;
+        }
+    }
+  return result;
+}
+
+void
+StreamSession::Impl::add_sinks ()
+{
+  // Every output runs on its own thread behind its own queue, so a slow
+  // disk cannot hold back the live outputs or the processing threads.
+  // Live outputs keep the newest frames, recordings the oldest. A dump
+  // waits for room instead, so its N frames are consecutive.
+  if (options_.dump_count > 0)
+    {
+      sinks_.add ("dump",
+                  sink_options ("dump", 1024, OverflowPolicy::Block,
+                                SinkInput::All, false),
+                  [this] (const SharedFrame &frame) {
+                    const int dump_count = options_.dump_count;
+                    if (saved_count_ >= dump_count)
+                      {
+                        return;
+                      }
+                    if (!dump_manager_.save_dump (frame.payload (),
+                                                  frame.payload_len (),
+                                                  saved_count_ + 1))
+                      {
+                        log_error ("Failed to save dump");
+                        return;
+                      }
+                    saved_count_++;
+                    log_info ("Saved dump ", saved_count_, "/", dump_count);
+                    if (saved_count_ >= dump_count)
+                      {
+                        log_info ("Dump complete. Exiting.");
+                        receiver_.stop ();
+                      }
+                  });
+    }
+  if (!captures_.empty ())
+    {
+      sinks_.add ("capture",
+                  sink_options ("capture", 4096, OverflowPolicy::DropNewest,
+                                SinkInput::All, false),
+                  [this] (const SharedFrame &frame) {
+                    captures_[frame.target ()]->append (frame.payload (),
+                                                        frame.payload_len ());
+                  });
+    }
+  if (ndjson_.is_open ())
+    {
+      sinks_.add (
+          "ndjson",
+          sink_options ("ndjson", 256, OverflowPolicy::DropOldest,
+                        SinkInput::Parsed, true),
+          [this] (const SharedFrame &frame) {
+            const ser::JonGUIState *state = frame.state ();
+            if (state == nullptr)
+              {
+                return;
+              }
+            ndjson_ << "{\"target\":" << frame.target ()
+                    << ",\"sequence\":" << frame.sequence ()
+                    << ",\"time_ns\":" << frame.published_ns ()
+                    << ",\"valid\":" << (frame.valid () ? "true" : "false")
+                    << ",\"state\":"
+                    << ndjson_converter_.to_json (*state, false) << "}\n";
+          },
+          [this] () { ndjson_.flush (); });
+    }
+  if (!publishers_.empty ())
+    {
+      // Each region has a single writer: this sink's thread
+      sinks_.add ("shm",
+                  sink_options ("shm", 16, OverflowPolicy::DropOldest,
+                                SinkInput::Valid, false),
+                  [this] (const SharedFrame &frame) {
+                    publishers_[frame.target ()]->publish (
+                        frame.payload (), frame.payload_len (),
+                        frame.sequence (),
+                        static_cast<uint32_t> (frame.target ()));
+                  });
+    }
+  if (!recorders_.empty ())
+    {
+      sinks_.add ("record",
+                  sink_options ("record", 4096, OverflowPolicy::DropNewest,
+                                SinkInput::Parsed, true),
+                  [this] (const SharedFrame &frame) {
+                    const ser::JonGUIState *state = frame.state ();
+                    if (state != nullptr)
+                      {
+                        recorders_[frame.target ()]->append (
+                            *state, frame.sequence (), frame.published_ns (),
+                            frame.valid ());
+                      }
+                  });
+    }
+}
+
+void
+StreamSession::Impl::process (const StateEvent &event)
+{
+  report_frame (hosts_[event.target], event);
+
+  if (comparator_ && event.state != nullptr)
+    {
+      comparator_->observe (event.target, *event.state);
+    }
+
+  if (!stores_.empty () && event.state != nullptr
+      && event.validation.is_valid)
+    {
+      stores_[event.target]->record (*event.state, unix_time_ns ());
+    }
+}
+
+bool
+StreamSession::Impl::run ()
+{
+  sinks_.start ();
+  if (!receiver_.start ())
+    {
+      sinks_.stop ();
+      log_error ("Failed to initiate connection");
+      return false;
+    }
+
+  rusage usage_before{};
+  getrusage (RUSAGE_SELF, &usage_before);
+  receiver_.run ();
+  rusage usage_after{};
+  getrusage (RUSAGE_SELF, &usage_after);
+  minor_faults_ = usage_after.ru_minflt - usage_before.ru_minflt;
+  major_faults_ = usage_after.ru_majflt - usage_before.ru_majflt;
+
+  sinks_.stop ();
+  return true;
+}
+
+void
+StreamSession::Impl::finish ()
+{
+  for (auto &host : hosts_)
+    {
+      if (host.violations)
+        {
+          std::vector<std::string> lines;
+          host.violations->flush (ViolationAggregator::Clock::now (), lines);
+          print_violation_summaries (host.tag, lines);
+        }
+    }
+
+  log_info ("Total messages received: ", received_count_);
+  const auto startup = receiver_.startup_stats ();
+  if (startup.first_validated_ms >= 0.0)
+    {
+      std::ostringstream line;
+      line.setf (std::ios::fixed);
+      line.precision (1);
+      line << "Time to first validated message: "
+           << startup.first_validated_ms << " ms (rules compiled in "
+           << startup.warmup_ms << " ms during connect";
+      if (startup.waited_ms >= 0.1)
+        {
+          line << ", first frame waited " << startup.waited_ms << " ms";
+        }
+      line << ")\n";
+      log_lines (LogLevel::Info, line.str ());
+    }
+  print_latency (receiver_.latency (), minor_faults_, major_faults_);
+  if (receiver_.dropped_count () > 0)
+    {
+      log_info ("Frames dropped (workers behind): ",
+                receiver_.dropped_count ());
+    }
+  const LogStats log_stats = Logger::instance ().stats ();
+  if (log_stats.dropped > log_stats.oversized)
+    {
+      log_info ("Log messages dropped (output behind): ",
+                log_stats.dropped - log_stats.oversized);
+    }
+  if (log_stats.oversized > 0)
+    {
+      log_info ("Log messages dropped (larger than ",
+                Logger::instance ().max_record_bytes (), " bytes): ",
+                log_stats.oversized);
+    }
+  for (size_t i = 0; i < sinks_.size (); ++i)
+    {
+      const auto stats = sinks_.stats (i);
+      const auto &queue = sinks_.options (i);
+      log_info ("Sink ", sinks_.name (i), ": ", stats.written, " written, ",
+                stats.dropped, " dropped (queue ", queue.capacity, " ",
+                overflow_policy_name (queue.overflow), ", peak ", stats.peak,
+                ")");
+    }
+
+  if (multi_host_)
+    {
+      log_info ("Per-host summary:");
+      for (size_t i = 0; i < hosts_.size (); ++i)
+        {
+          const auto &host = hosts_[i];
+          const auto stats = receiver_.connection_stats (i);
+          const auto &sequence = receiver_.sequence_stats (i);
+          log_info ("  ", host.tag, "messages=", host.messages,
+                    " bytes=", host.bytes, " valid=", host.valid,
+                    " invalid=", host.invalid,
+                    " parse_errors=", host.parse_errors,
+                    " not_printed=", host.throttle.suppressed_count (),
+                    " reconnects=", stats.reconnects,
+                    " outage_ms=", static_cast<uint64_t> (stats.total_outage_ms),
+                    " missed~", stats.estimated_missed_frames,
+                    " gaps=", sequence.gaps, " missing~", sequence.missing,
+                    " duplicates=", sequence.duplicates,
+                    " late=", sequence.out_of_order);
+        }
+    }
+  else
+    {
+      if (hosts_[0].throttle.is_active ())
+        {
+          log_info ("Frames validated but not printed: ",
+                    hosts_[0].throttle.suppressed_count ());
+        }
+      const auto stats = receiver_.connection_stats (0);
+      if (stats.reconnects > 0)
+        {
+          log_info ("Reconnects: ", stats.reconnects, " (last ",
+                    static_cast<uint64_t> (stats.last_reconnect_ms),
+                    " ms, max ", static_cast<uint64_t> (stats.max_reconnect_ms),
+                    " ms, total outage ",
+                    static_cast<uint64_t> (stats.total_outage_ms), " ms, ~",
+                    stats.estimated_missed_frames, " frames missed)");
+        }
+      print_sequence_stats (receiver_.sequence_stats (0),
+                            options_.receiver.skip_duplicates);
+    }
+
+  for (auto &recorder : recorders_)
+    {
+      if (!recorder->close ())
+        {
+          log_error ("Error: failed to write recording");
+        }
+    }
+  for (size_t i = 0; i < captures_.size (); ++i)
+    {
+      if (!captures_[i]->close ())
+        {
+          log_error ("Error: failed to write capture");
+        }
+      log_info (hosts_[i].tag, "Captured ", captures_[i]->frames (),
+                " frames: ", describe_store_size (*captures_[i]));
+    }
+  if (comparator_)
+    {
+      const auto stats = comparator_->stats ();
+      log_info ("Compared ", stats.aligned, " aligned frames: ",
+                stats.mismatched, " field values out of tolerance, ",
+                stats.differing, " still differing (unmatched=",
+                stats.unmatched, " late=", stats.late,
+                " unaligned=", stats.unaligned, ")");
+    }
+  if (!recorders_.empty ())
+    {
+      std::string rows;
+      for (const auto &recorder : recorders_)
+        {
+          rows += " " + std::to_string (recorder->rows ());
+        }
+      log_info ("Recorded rows:", rows);
+    }
+
+  for (const auto &publisher : publishers_)
+    {
+      if (publisher->oversized_count () > 0)
+        {
+          log_info ("Shared memory ", publisher->name (), ": ",
+                    publisher->oversized_count (),
+                    " payloads too large, not published");
+        }
+    }
+
+  if (options_.receiver.deflate.enabled)
+    {
+      log_info ("Compression:");
+      for (size_t i = 0; i < hosts_.size (); ++i)
+        {
+          print_deflate_stats (hosts_[i].tag, receiver_.connection_stats (i));
+        }
+    }
+}
+
+StreamSession::StreamSession (StreamOptions options)
+    : pimpl_ (std::make_unique<Impl> (std::move (options)))
+{
+}
+
+StreamSession::~StreamSession () = default;
+
+bool
+StreamSession::open ()
+{
+  return pimpl_->open ();
+}
+
+bool
+StreamSession::run ()
+{
+  return pimpl_->run ();
+}
+
+void
+StreamSession::stop ()
+{
+  pimpl_->receiver ().stop ();
+}
+
+void
+StreamSession::finish ()
+{
+  pimpl_->finish ();
+}
+
+const std::vector<std::unique_ptr<HistoryStore>> &
+StreamSession::history () const
+{
+  return pimpl_->history ();
+}
+
+} // namespace jettison
@@ -0,0 +1,133 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 Jettison Project Team
+
+#ifndef STREAM_SESSION_H
+#define STREAM_SESSION_H
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "field_watcher.h"
+#include "history_store.h"
+#include "receiver.h"
+#include "sink_graph.h"
+#include "state_comparator.h"
+
+namespace jettison
+{
+
+/**
+ * @brief Queue settings overriding one sink's defaults
+ */
+struct SinkQueueSpec
+{
+  size_t capacity = 0;                    // 0 = the sink's default
+  std::optional<OverflowPolicy> overflow; // Unset = the sink's default
+};
+
+/**
+ * @brief What a StreamSession receives and what it does with the frames
+ */
+struct StreamOptions
+{
+  ReceiverOptions receiver; // Targets, workers, reconnect, deflate...
+  int dump_count = 0;       // Dump N payloads, then stop (0 = no dumps)
+  double max_hz = 0.0;      // Report valid frames at most N times/s (0 = all)
+  uint32_t every_k = 0;     // Report only every Kth valid frame (0 = all)
+  double violation_window = 10.0; // Summarize repeats (0 = report every
+                                  // frame)
+  std::string shm_name;     // Publish latest valid state to shared memory
+  std::vector<FieldWatchSpec> watches; // Report field changes instead
+  std::string record_file;  // Record numeric fields as columns
+  std::string capture_file; // Record raw payloads to a dump store
+  std::string ndjson_file;  // Stream parsed frames as JSON lines
+  std::map<std::string, SinkQueueSpec> sink_queues; // By sink name
+  std::vector<std::string> history_fields; // Keep field history
+  std::vector<CompareSpec> compares; // Compare fields across targets
+  std::string align_by; // Field compared frames are aligned by
+};
+
+/**
+ * @brief A complete streaming session: a Receiver plus everything done
+ * with its frames
+ *
+ * Each frame is reported through the logger (rate-controlled, with
+ * repeated violations summarized per target, or only as field changes
+ * when watches are set), fed to the cross-target comparator and the
+ * history stores, and published to a SinkGraph holding the dump,
+ * capture, NDJSON, shared-memory and column-recording outputs. Every
+ * message, including the summary, goes through the logger, so the
+ * caller only has to start it around run().
+ *
+ * With several targets, each target's lines are prefixed with
+ * "[host:port] " and its files are named file.N.ext.
+ */
+class StreamSession
+{
+public:
+  /**
+   * @brief Construct a session (nothing is opened yet)
+   * @param options What to receive and which outputs to create
+   */
+  explicit StreamSession (StreamOptions options);
+
+  /**
+   * @brief Stop the outputs, writing what is queued
+   */
+  ~StreamSession ();
+
+  // Non-copyable, non-movable (callbacks point back to the session)
+  StreamSession (const StreamSession &) = delete;
+  StreamSession &operator= (const StreamSession &) = delete;
+  StreamSession (StreamSession &&) = delete;
+  StreamSession &operator= (StreamSession &&) = delete;
+
+  /**
+   * @brief Create the outputs and connect the reporting
+   * @return true on success; on failure the reason has been logged
+   */
+  bool open ();
+
+  /**
+   * @brief Connect and stream until stop(), the dump is complete or all
+   * connections end
+   * @return false if no connection could be initiated
+   */
+  bool run ();
+
+  /**
+   * @brief Stop streaming (async-signal-safe, thread-safe)
+   */
+  void stop ();
+
+  /**
+   * @brief Close the recordings and log the session summary
+   *
+   * Call after run() returned.
+   */
+  void finish ();
+
+  /**
+   * @brief Get the history stores, one per target (empty without
+   * history fields)
+   *
+   * Samples are recorded by the processing threads against Unix time in
+   * ns; HistoryStore queries are thread-safe.
+   *
+   * @return Stores, indexed by target
+   */
+  const std::vector<std::unique_ptr<HistoryStore>> &history () const;
+
+private:
+  class Impl;
+  std::unique_ptr<Impl> pimpl_;
+};
+
+} // namespace jettison
+
+#endif // STREAM_SESSION_H
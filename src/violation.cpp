@@ -0,0 +1,184 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 Jettison Project Team
+
+#include "violation.h"
+#include <cmath>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <sstream>
+#include <unordered_map>
+#include <vector>
+
+namespace jettison
+{
+
+namespace
+{
+
+struct StringHash
+{
+  using is_transparent = void;
+
+  size_t operator() (std::string_view text) const
+  {
+    return std::hash<std::string_view>{}(text);
+  }
+};
+
+struct Table
+{
+  std::mutex mutex;
+  std::deque<std::string> names{ std::string () }; // Stable references
+  std::unordered_map<std::string, uint32_t, StringHash, std::equal_to<>>
+      ids{ { std::string (), 0 } };
+};
+
+Table &
+table ()
+{
+  static Table instance;
+  return instance;
+}
+
+} // namespace
+
+uint32_t
+RuleTable::intern (std::string_view text)
+{
+  if (text.empty ())
+    {
+      return 0;
+    }
+
+  // Keys point into the process-wide names, which are never removed
+  thread_local std::unordered_map<std::string_view, uint32_t> cache;
+  const auto cached = cache.find (text);
+  if (cached != cache.end ())
+    {
+      return cached->second;
+    }
+
+  auto &t = table ();
+  std::lock_guard<std::mutex> lock (t.mutex);
+  auto it = t.ids.find (text);
+  if (it == t.ids.end ())
+    {
+      const auto id = static_cast<uint32_t> (t.names.size ());
+      t.names.emplace_back (text);
+      it = t.ids.emplace (t.names.back (), id).first;
+    }
+  cache.emplace (it->first, it->second);
+  return it->second;
+}
+
+const std::string &
+RuleTable::name (uint32_t id)
+{
+  // Entries point into the process-wide names, which are never removed
+  thread_local std::vector<const std::string *> cache;
+  if (id < cache.size () && cache[id] != nullptr)
+    {
+      return *cache[id];
+    }
+
+  auto &t = table ();
+  std::lock_guard<std::mutex> lock (t.mutex);
+  if (id >= t.names.size ())
+    {
+      return t.names[0];
+    }
+  if (id >= cache.size ())
+    {
+      cache.resize (id + 1, nullptr);
+    }
+  cache[id] = &t.names[id];
+  return t.names[id];
+}
+
+std::string
+FieldPath::to_string (const google::protobuf::Descriptor *root) const
+{
+  if (depth == 0)
+    {
+      return "<root>";
+    }
+
+  std::string path;
+  const google::protobuf::Descriptor *type = root;
+  for (size_t i = 0; i < depth; ++i)
+    {
+      if (i > 0)
+        {
+          path += '.';
+        }
+
+      const auto *field
+          = type != nullptr ? type->FindFieldByNumber (numbers[i]) : nullptr;
+      if (field == nullptr)
+        {
+          path += '#' + std::to_string (numbers[i]);
+          type = nullptr;
+          continue;
+        }
+      path += field->name ();
+      type = field->message_type ();
+    }
+  return path;
+}
+
+std::string
+Violation::to_string () const
+{
+  std::ostringstream out;
+  out.precision (6);
+
+  switch (kind)
+    {
+    case Kind::Parse:
+      out << "Failed to parse protobuf message";
+      break;
+    case Kind::Error:
+      out << "Validation error: " << detail;
+      break;
+    case Kind::Missing:
+      out << "Missing required field: " << field.to_string ();
+      break;
+    case Kind::Jump:
+      out << "Anomaly: '" << field.to_string () << "' jumped by " << value
+          << " in one frame (typical step " << context[0] << " ± "
+          << context[1] << ")";
+      break;
+    case Kind::Spike:
+      out << "Anomaly: '" << field.to_string () << "' = " << value
+          << " is far from its recent mean " << context[0] << " ± "
+          << context[1];
+      break;
+    case Kind::Stuck:
+      out << "Anomaly: '" << field.to_string () << "' stuck at " << value
+          << " for " << context[0] << " s";
+      break;
+    case Kind::Rule:
+    default:
+      out << "Field '" << field.to_string () << "': " << detail;
+      if (!std::isnan (value))
+        {
+          out << " (value: " << value << ")";
+        }
+      if (rule != 0)
+        {
+          out << " (rule: " << RuleTable::name (rule) << ")";
+        }
+      break;
+    }
+
+  return out.str ();
+}
+
+std::ostream &
+operator<< (std::ostream &out, const Violation &violation)
+{
+  return out << violation.to_string ();
+}
+
+} // namespace jettison
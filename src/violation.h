@@ -0,0 +1,142 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 Jettison Project Team
+
+#ifndef VIOLATION_H
+#define VIOLATION_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+#include "jon_shared_data.pb.h"
+
+namespace jettison
+{
+
+/**
+ * @brief Field path stored as field numbers, e.g. {10, 1} for
+ * "compass.azimuth"
+ *
+ * Fixed-size so recording a violation never allocates; names are looked
+ * up from the descriptors only when the path is printed.
+ */
+struct FieldPath
+{
+  static constexpr size_t MAX_DEPTH = 7;
+
+  std::array<int32_t, MAX_DEPTH> numbers{};
+  uint8_t depth = 0; // 0 = the root message itself
+
+  /**
+   * @brief Append a field number (ignored beyond MAX_DEPTH)
+   * @param number Field number
+   */
+  void push (int32_t number)
+  {
+    if (depth < MAX_DEPTH)
+      {
+        numbers[depth++] = number;
+      }
+  }
+
+  bool operator== (const FieldPath &other) const
+  {
+    return depth == other.depth
+           && std::equal (numbers.begin (), numbers.begin () + depth,
+                          other.numbers.begin ());
+  }
+
+  /**
+   * @brief Format as a dotted name path
+   * @param root Message type the path starts from
+   * @return e.g. "compass.azimuth", "<root>" for an empty path
+   */
+  std::string to_string (const google::protobuf::Descriptor *root
+                         = ser::JonGUIState::descriptor ()) const;
+};
+
+/**
+ * @brief Process-wide table of interned rule ids
+ *
+ * The set of distinct rule ids is bounded by the schema, so each is
+ * stored once and violations carry a 32-bit id. Id 0 is the empty
+ * string. Only intern schema-bound text: constraint messages can embed
+ * values (e.g. a CEL rule's own text), and free-form text such as status
+ * messages would grow the table without limit.
+ *
+ * Thread-safe. Each thread keeps its own cache of the ids and names it
+ * has seen, so after first sight neither intern() nor name() takes a
+ * lock.
+ */
+class RuleTable
+{
+public:
+  /**
+   * @brief Get the id of a string, adding it on first use
+   * @param text String to intern
+   * @return Stable id
+   */
+  static uint32_t intern (std::string_view text);
+
+  /**
+   * @brief Get the string for an id
+   * @param id Id from intern()
+   * @return Interned string (valid for the life of the process)
+   */
+  static const std::string &name (uint32_t id);
+};
+
+/**
+ * @brief One validation error or warning, recorded without formatting
+ *
+ * Holds what a consumer needs to act on a violation (which field, which
+ * rule, what value) as plain data. The human-readable text is produced
+ * by to_string() / operator<< only when something prints it, so streams
+ * with many violations per frame cost no string building.
+ */
+struct Violation
+{
+  enum class Kind : uint8_t
+  {
+    Parse,   // Message did not parse
+    Error,   // Validator itself failed (detail = status text)
+    Rule,    // buf.validate rule violated
+    Missing, // Required sub-message missing (basic validation)
+    Jump,    // Anomaly: step far outside the typical step
+    Spike,   // Anomaly: value far outside the recent mean
+    Stuck    // Anomaly: varying field frozen
+  };
+
+  static constexpr double NONE = std::numeric_limits<double>::quiet_NaN ();
+
+  Kind kind = Kind::Rule;
+  FieldPath field;            // Offending field
+  uint32_t rule = 0;          // Interned rule id (0 = none)
+  std::string detail;         // Rule: constraint message; Error: status
+                              // text
+  double value = NONE;        // Field value, or the step for Jump
+  std::array<double, 2> context{ NONE, NONE }; // Kind-specific: mean and
+                                               // std deviation for Jump
+                                               // and Spike, seconds for
+                                               // Stuck
+
+  /**
+   * @brief Format the violation for display
+   * @return Human-readable text
+   */
+  std::string to_string () const;
+};
+
+/**
+ * @brief Write Violation::to_string() to a stream
+ */
+std::ostream &operator<< (std::ostream &out, const Violation &violation);
+
+} // namespace jettison
+
+#endif // VIOLATION_H
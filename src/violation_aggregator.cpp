@@ -0,0 +1,189 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 Jettison Project Team
+
+#include "violation_aggregator.h"
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+namespace jettison
+{
+
+namespace
+{
+
+/**
+ * @brief Format a count with thousands separators, e.g. 4,210
+ */
+std::string
+with_commas (uint64_t count)
+{
+  std::string digits = std::to_string (count);
+  for (size_t i = digits.size (); i > 3; i -= 3)
+    {
+      digits.insert (i - 3, 1, ',');
+    }
+  return digits;
+}
+
+/**
+ * @brief Name a (field, rule) key for summary lines
+ */
+std::string
+label (const Violation &violation)
+{
+  if (violation.rule != 0)
+    {
+      return "Field '" + violation.field.to_string ()
+             + "' (rule: " + RuleTable::name (violation.rule) + ")";
+    }
+
+  switch (violation.kind)
+    {
+    case Violation::Kind::Parse:
+      return "Parse errors";
+    case Violation::Kind::Error:
+      return "Validation errors";
+    case Violation::Kind::Missing:
+      return "Missing field '" + violation.field.to_string () + "'";
+    default:
+      return "Field '" + violation.field.to_string () + "'";
+    }
+}
+
+long long
+whole_seconds (ViolationAggregator::Clock::duration duration)
+{
+  return std::llround (std::chrono::duration<double> (duration).count ());
+}
+
+} // namespace
+
+size_t
+ViolationAggregator::KeyHash::operator() (const Key &key) const
+{
+  size_t hash = (static_cast<size_t> (key.rule) << 8)
+                ^ static_cast<size_t> (key.kind);
+  for (size_t i = 0; i < key.field.depth; ++i)
+    {
+      hash = hash * 31 + static_cast<size_t> (key.field.numbers[i]);
+    }
+  return hash;
+}
+
+ViolationAggregator::ViolationAggregator (Config config) : config_ (config)
+{
+}
+
+bool
+ViolationAggregator::add (const std::vector<Violation> &violations,
+                          Clock::time_point now)
+{
+  if (!started_)
+    {
+      window_start_ = now;
+      next_scan_ = now;
+      started_ = true;
+    }
+
+  bool fresh = false;
+  for (const auto &violation : violations)
+    {
+      Entry &entry
+          = entries_[Key{ violation.field, violation.rule, violation.kind }];
+      if (entry.active)
+        {
+          entry.unreported++;
+          suppressed_++;
+        }
+      else
+        {
+          // First occurrence of an episode is printed by the caller
+          entry.active = true;
+          entry.started = now;
+          entry.episode = 0;
+          entry.unreported = 0;
+          fresh = true;
+        }
+      entry.episode++;
+      entry.last = violation;
+      entry.last_seen = now;
+    }
+
+  return fresh;
+}
+
+void
+ViolationAggregator::summarize (const Entry &entry, Clock::time_point now,
+                                std::vector<std::string> &lines) const
+{
+  std::ostringstream line;
+  line.precision (6);
+  line << label (entry.last) << ": " << with_commas (entry.unreported)
+       << (entry.unreported == 1 ? " violation" : " violations")
+       << " in last "
+       << std::max (1LL, whole_seconds (now - window_start_)) << " s";
+  if (!std::isnan (entry.last.value))
+    {
+      line << " (last value " << entry.last.value << ")";
+    }
+  lines.push_back (line.str ());
+}
+
+void
+ViolationAggregator::poll (Clock::time_point now,
+                           std::vector<std::string> &lines)
+{
+  if (!started_ || now < next_scan_)
+    {
+      return;
+    }
+  next_scan_ = now + std::min<Clock::duration> (std::chrono::seconds (1),
+                                                config_.clear_after);
+
+  if (now - window_start_ >= config_.window)
+    {
+      flush (now, lines);
+    }
+
+  for (auto &[key, entry] : entries_)
+    {
+      if (entry.active && now - entry.last_seen > config_.clear_after)
+        {
+          lines.push_back (
+              label (entry.last) + ": cleared after "
+              + with_commas (entry.episode)
+              + (entry.episode == 1 ? " violation in " : " violations in ")
+              + std::to_string (whole_seconds (entry.last_seen
+                                               - entry.started))
+              + " s");
+          entry.active = false;
+          entry.unreported = 0;
+        }
+    }
+}
+
+void
+ViolationAggregator::flush (Clock::time_point now,
+                            std::vector<std::string> &lines)
+{
+  for (auto &[key, entry] : entries_)
+    {
+      if (entry.unreported > 0)
+        {
+          summarize (entry, now, lines);
+          entry.unreported = 0;
+        }
+    }
+  window_start_ = now;
+}
+
+size_t
+ViolationAggregator::active_count () const
+{
+  return static_cast<size_t> (
+      std::count_if (entries_.begin (), entries_.end (),
+                     [] (const auto &item) { return item.second.active; }));
+}
+
+} // namespace jettison
@@ -0,0 +1,138 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 Jettison Project Team
+
+#ifndef VIOLATION_AGGREGATOR_H
+#define VIOLATION_AGGREGATOR_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "violation.h"
+
+namespace jettison
+{
+
+/**
+ * @brief Rate-limits repeated violations of the same rule on the same
+ * field
+ *
+ * Violations are counted per (field path, rule) key. add() reports
+ * whether a frame brought a key that is not currently active, so its
+ * first occurrence can be printed in full; after that the key is only
+ * counted, and poll() produces one summary line per key per window
+ * ("... 4,210 violations in last 10 s") and a line when a key has not
+ * been seen for clear_after ("... cleared").
+ *
+ * Counting a known violation is one hash lookup and an increment. One
+ * aggregator follows one stream; it is not thread-safe.
+ */
+class ViolationAggregator
+{
+public:
+  using Clock = std::chrono::steady_clock;
+
+  static constexpr std::chrono::hours MAX_WINDOW{ 24 }; // Longest window
+
+  /**
+   * @brief Aggregation intervals
+   */
+  struct Config
+  {
+    Clock::duration window = std::chrono::seconds (10); // Summary period
+    Clock::duration clear_after = std::chrono::seconds (2); // Quiet time
+                                                            // to clear
+  };
+
+  /**
+   * @brief Construct an aggregator
+   * @param config Intervals
+   */
+  explicit ViolationAggregator (Config config);
+  ViolationAggregator () : ViolationAggregator (Config{}) {}
+
+  /**
+   * @brief Count one frame's violations
+   * @param violations Errors or warnings of the frame
+   * @param now Arrival time of the frame
+   * @return true if any violation started a new (inactive) key
+   */
+  bool add (const std::vector<Violation> &violations, Clock::time_point now);
+
+  /**
+   * @brief Emit due summaries and clear notices
+   *
+   * Call it from a timer rather than per frame, so summaries and clear
+   * notices are on time when the stream goes quiet. Cheap to call often:
+   * keys are only scanned about once per second.
+   *
+   * @param now Current time
+   * @param lines Receives one line per summary or cleared key
+   */
+  void poll (Clock::time_point now, std::vector<std::string> &lines);
+
+  /**
+   * @brief Emit the counts of the current, unfinished window
+   * @param now Current time
+   * @param lines Receives one line per key with unreported violations
+   */
+  void flush (Clock::time_point now, std::vector<std::string> &lines);
+
+  /**
+   * @brief Get the number of keys currently active
+   * @return Active key count
+   */
+  size_t active_count () const;
+
+  /**
+   * @brief Get the number of violations counted but not printed in full
+   * @return Suppressed violation count
+   */
+  uint64_t suppressed_count () const { return suppressed_; }
+
+private:
+  struct Key
+  {
+    FieldPath field;
+    uint32_t rule;
+    Violation::Kind kind;
+
+    bool operator== (const Key &other) const
+    {
+      return rule == other.rule && kind == other.kind
+             && field == other.field;
+    }
+  };
+
+  struct KeyHash
+  {
+    size_t operator() (const Key &key) const;
+  };
+
+  struct Entry
+  {
+    Violation last;              // Most recent occurrence
+    uint64_t unreported = 0;     // Counted since the last line
+    uint64_t episode = 0;        // Count since the key became active
+    Clock::time_point started;   // First occurrence of this episode
+    Clock::time_point last_seen; // Most recent occurrence
+    bool active = false;
+  };
+
+  void summarize (const Entry &entry, Clock::time_point now,
+                  std::vector<std::string> &lines) const;
+
+  Config config_;
+  std::unordered_map<Key, Entry, KeyHash> entries_;
+  Clock::time_point window_start_;
+  Clock::time_point next_scan_;
+  bool started_ = false;
+  uint64_t suppressed_ = 0;
+};
+
+} // namespace jettison
+
+#endif // VIOLATION_AGGREGATOR_H
@@ -2,22 +2,97 @@
 // Copyright (C) 2025 Jettison Project Team
 
 #include "websocket_client.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
 #include <cstring>
+#include <deque>
 #include <iostream>
 #include <libwebsockets.h>
 #include <memory>
+#include <mutex>
+#include <random>
+#include <ctime>
+#include <sys/eventfd.h>
+#include <unistd.h>
 #include <vector>
 
 namespace jettison
 {
 
+std::string
+Endpoint::to_uri () const
+{
+  return std::string (use_tls ? "wss://" : "ws://") + host + ":"
+         + std::to_string (port) + path;
+}
+
+std::optional<Endpoint>
+parse_endpoint (const std::string &spec)
+{
+  Endpoint endpoint;
+  std::string rest = spec;
+
+  if (rest.rfind ("wss://", 0) == 0)
+    {
+      rest = rest.substr (6);
+    }
+  else if (rest.rfind ("ws://", 0) == 0)
+    {
+      rest = rest.substr (5);
+      endpoint.use_tls = false;
+      endpoint.port = 80;
+    }
+
+  // Split off the path
+  const size_t slash = rest.find ('/');
+  if (slash != std::string::npos)
+    {
+      endpoint.path = rest.substr (slash);
+      rest = rest.substr (0, slash);
+    }
+
+  // Split off the port
+  const size_t colon = rest.rfind (':');
+  if (colon != std::string::npos)
+    {
+      try
+        {
+          size_t consumed = 0;
+          const std::string port_str = rest.substr (colon + 1);
+          endpoint.port = std::stoi (port_str, &consumed);
+          if (consumed != port_str.size () || endpoint.port <= 0
+              || endpoint.port > 65535)
+            {
+              return std::nullopt;
+            }
+        }
+      catch (...)
+        {
+          return std::nullopt;
+        }
+      rest = rest.substr (0, colon);
+    }
+
+  if (rest.empty ())
+    {
+      return std::nullopt;
+    }
+
+  endpoint.host = rest;
+  return endpoint;
+}
+
 class WebSocketClient::Impl
 {
 public:
-  Impl (const std::string &host, int port, const std::string &path)
-      : host_ (host), port_ (port), path_ (path), context_ (nullptr),
-        wsi_ (nullptr), connected_ (false), should_disconnect_ (false)
+  Impl ()
+      : context_ (nullptr), should_disconnect_ (false),
+        rng_ (std::random_device{}()), wake_fd_ (-1)
   {
+    // Wakes the event loop from other threads or signal handlers
+    wake_fd_ = eventfd (0, EFD_NONBLOCK | EFD_CLOEXEC);
   }
 
   ~Impl ()
@@ -27,6 +102,60 @@ public:
       {
         lws_context_destroy (context_);
       }
+    if (wake_fd_ >= 0)
+      {
+        close (wake_fd_);
+      }
+  }
+
+  size_t
+  add_target (const Endpoint &endpoint)
+  {
+    auto conn = std::make_unique<Connection> ();
+    conn->owner = this;
+    conn->timer.conn = conn.get ();
+    conn->index = connections_.size ();
+    conn->endpoint = endpoint;
+    connections_.push_back (std::move (conn));
+    return connections_.size () - 1;
+  }
+
+  size_t
+  target_count () const
+  {
+    return connections_.size ();
+  }
+
+  const Endpoint &
+  get_target (size_t target) const
+  {
+    return connections_.at (target)->endpoint;
+  }
+
+  void
+  set_deflate_options (const DeflateOptions &options)
+  {
+    deflate_ = options;
+  }
+
+  void
+  set_reconnect_policy (const ReconnectPolicy &policy)
+  {
+    policy_ = policy;
+  }
+
+  void
+  set_timer (std::chrono::milliseconds interval,
+             std::function<void ()> callback)
+  {
+    timer_interval_ = interval;
+    timer_callback_ = std::move (callback);
+  }
+
+  ConnectionStats
+  get_stats (size_t target) const
+  {
+    return connections_.at (target)->stats;
   }
 
   void
@@ -47,10 +176,16 @@ public:
     error_callback_ = std::move (callback);
   }
 
+  void
+  set_status_callback (StatusCallback callback)
+  {
+    status_callback_ = std::move (callback);
+  }
+
   bool
   connect ()
   {
-    // Create context
+    // Create one context shared by all connections
     struct lws_context_creation_info info;
     std::memset (&info, 0, sizeof (info));
 
@@ -64,53 +199,71 @@ public:
     info.ssl_cert_filepath = nullptr;
     info.ssl_private_key_filepath = nullptr;
 
-    context_ = lws_create_context (&info);
-    if (context_ == nullptr)
+    if (deflate_.enabled)
       {
-        if (error_callback_)
+#if !defined(LWS_WITHOUT_EXTENSIONS)
+        deflate_offer_ = build_deflate_offer (deflate_);
+        extensions_[0] = { "permessage-deflate", deflate_ext_callback,
+                           deflate_offer_.c_str () };
+        extensions_[1] = { nullptr, nullptr, nullptr };
+        info.extensions = extensions_;
+        for (auto &conn : connections_)
           {
-            error_callback_ ("Failed to create libwebsockets context");
+            conn->stats.deflate_offered = true;
           }
-        return false;
+#else
+        report_error (0, "permessage-deflate requested but libwebsockets "
+                         "was built without extensions");
+#endif
       }
 
-    // Setup connection info
-    struct lws_client_connect_info ccinfo;
-    std::memset (&ccinfo, 0, sizeof (ccinfo));
+#if defined(LWS_WITH_TLS_SESSIONS)
+    // The context outlives individual connections, so its client TLS
+    // session cache lets reconnects resume instead of full handshakes
+    info.tls_session_timeout = 3600;
+    info.tls_session_cache_max
+        = static_cast<uint32_t> (std::max<size_t> (connections_.size (), 1)
+                                 * 2);
+#endif
 
-    ccinfo.context = context_;
-    ccinfo.address = host_.c_str ();
-    ccinfo.port = port_;
-    ccinfo.path = path_.c_str ();
-    ccinfo.host = host_.c_str ();
-    ccinfo.origin = host_.c_str ();
-    ccinfo.protocol = "binary"; // Use binary protocol
-    ccinfo.ssl_connection = LCCSCF_USE_SSL
-                            | LCCSCF_ALLOW_SELFSIGNED
-                            | LCCSCF_SKIP_SERVER_CERT_HOSTNAME_CHECK
-                            | LCCSCF_ALLOW_EXPIRED
-                            | LCCSCF_ALLOW_INSECURE;
-    ccinfo.userdata = this;
+    context_ = lws_create_context (&info);
+    if (context_ == nullptr)
+      {
+        report_error (0, "Failed to create libwebsockets context");
+        return false;
+      }
 
-    wsi_ = lws_client_connect_via_info (&ccinfo);
-    if (wsi_ == nullptr)
+    // disconnect() must be able to wake the loop with a plain write(2),
+    // so without the eventfd in the loop there is no usable client
+    if (!adopt_wake_fd ())
       {
-        if (error_callback_)
-          {
-            error_callback_ ("Failed to initiate connection");
-          }
+        report_error (0, "Failed to add the wake-up eventfd to the event "
+                         "loop");
+        lws_context_destroy (context_);
+        context_ = nullptr;
         return false;
       }
+    schedule_timer ();
 
-    return true;
+    bool any_started = false;
+    for (auto &conn : connections_)
+      {
+        any_started = connect_one (*conn) || any_started;
+      }
+
+    // A target that failed right away (e.g. a device still booting, not
+    // yet in DNS) has a reconnect scheduled; run() keeps retrying it
+    return any_started || policy_.enabled;
   }
 
   void
   run ()
   {
-    while (!should_disconnect_ && context_ != nullptr)
+    // lws_service() sleeps until socket activity, an lws timer (e.g. a
+    // reconnect) or a wake-up via wake_fd_, so there is no polling interval
+    while (!should_disconnect_ && context_ != nullptr && any_active ())
       {
-        int n = lws_service (context_, 50); // 50ms timeout
+        int n = lws_service (context_, 0);
         if (n < 0)
           {
             break;
@@ -121,26 +274,52 @@ public:
   void
   disconnect ()
   {
+    // Only an atomic store and write(2): safe from any thread and from
+    // signal handlers. The event loop wakes up and returns from run().
     should_disconnect_ = true;
-    if (wsi_ != nullptr && connected_)
-      {
-        lws_callback_on_writable (wsi_);
-      }
+    wake ();
+  }
+
+  void
+  post (std::function<void ()> command)
+  {
+    {
+      std::lock_guard<std::mutex> lock (commands_mutex_);
+      commands_.push_back (std::move (command));
+    }
+    wake ();
   }
 
   bool
   is_connected () const
   {
-    return connected_;
+    return connected_count () > 0;
+  }
+
+  size_t
+  connected_count () const
+  {
+    size_t count = 0;
+    for (const auto &conn : connections_)
+      {
+        if (conn->connected)
+          {
+            count++;
+          }
+      }
+    return count;
   }
 
   // Static callback for libwebsockets
   static int
   callback_function (struct lws *wsi, enum lws_callback_reasons reason,
-                     void * /*user*/, void *in, size_t len)
+                     void *user, void *in, size_t len)
   {
     Impl *impl = static_cast<Impl *> (lws_context_user (lws_get_context (wsi)));
-    if (impl == nullptr)
+
+    // Per-connection state is passed as the wsi user data (ccinfo.userdata)
+    Connection *conn = static_cast<Connection *> (user);
+    if (impl == nullptr || conn == nullptr)
       {
         return 0;
       }
@@ -148,11 +327,12 @@ public:
     switch (reason)
       {
       case LWS_CALLBACK_CLIENT_ESTABLISHED:
-        impl->connected_ = true;
-        impl->wsi_ = wsi;
+        conn->connected = true;
+        conn->wsi = wsi;
+        impl->on_established (*conn);
         if (impl->connection_callback_)
           {
-            impl->connection_callback_ (true);
+            impl->connection_callback_ (conn->index, true);
           }
         break;
 
@@ -160,13 +340,10 @@ public:
         {
           const char *error_msg = in != nullptr ? static_cast<const char *> (in)
                                                  : "Unknown error";
-          if (impl->error_callback_)
-            {
-              impl->error_callback_ (std::string ("Connection error: ")
-                                     + error_msg);
-            }
-          impl->connected_ = false;
-          impl->should_disconnect_ = true;
+          impl->report_error (conn->index,
+                              std::string ("Connection error: ") + error_msg);
+          conn->stats.failed_attempts++;
+          impl->on_lost (*conn);
         }
         break;
 
@@ -175,44 +352,25 @@ public:
           const uint8_t *data = static_cast<const uint8_t *> (in);
           if (impl->message_callback_ && data != nullptr && len > 0)
             {
-              // Check if this is the final fragment
-              int is_final = lws_is_final_fragment (wsi);
-
-              if (is_final != 0)
-                {
-                  // For simplicity, we handle single-frame messages
-                  // Multi-frame would require buffering
-                  impl->message_callback_ (data, len);
-                }
-              else
-                {
-                  // Handle fragmented messages by buffering
-                  impl->rx_buffer_.insert (impl->rx_buffer_.end (), data,
-                                           data + len);
-
-                  // This check is redundant but safe
-                  if (is_final != 0 && !impl->rx_buffer_.empty ())
-                    {
-                      impl->message_callback_ (impl->rx_buffer_.data (),
-                                               impl->rx_buffer_.size ());
-                      impl->rx_buffer_.clear ();
-                    }
-                }
+              impl->receive (*conn, wsi, data, len);
             }
         }
         break;
 
       case LWS_CALLBACK_CLIENT_CLOSED:
-        impl->connected_ = false;
+        conn->stats.disconnects++;
         if (impl->connection_callback_)
           {
-            impl->connection_callback_ (false);
+            impl->connection_callback_ (conn->index, false);
           }
-        impl->should_disconnect_ = true;
+        impl->on_lost (*conn);
         break;
 
       case LWS_CALLBACK_WSI_DESTROY:
-        impl->wsi_ = nullptr;
+        if (conn->wsi == wsi)
+          {
+            conn->wsi = nullptr;
+          }
         break;
 
       default:
@@ -223,25 +381,495 @@ public:
     return 0;
   }
 
+#if !defined(LWS_WITHOUT_EXTENSIONS)
+  // Wraps the stock permessage-deflate extension to account for
+  // compressed/decompressed bytes and inflate CPU time per connection
+  static int
+  deflate_ext_callback (struct lws_context *context,
+                        const struct lws_extension *ext, struct lws *wsi,
+                        enum lws_extension_callback_reasons reason, void *user,
+                        void *in, size_t len)
+  {
+    Connection *conn = wsi != nullptr
+                           ? static_cast<Connection *> (lws_wsi_user (wsi))
+                           : nullptr;
+
+    if (reason == LWS_EXT_CB_CLIENT_CONSTRUCT && conn != nullptr)
+      {
+        conn->stats.deflate_negotiated = true;
+      }
+
+    if (reason != LWS_EXT_CB_PAYLOAD_RX || in == nullptr || conn == nullptr)
+      {
+        return lws_extension_callback_pm_deflate (context, ext, wsi, reason,
+                                                  user, in, len);
+      }
+
+    auto *pmdrx = static_cast<struct lws_ext_pm_deflate_rx_ebufs *> (in);
+    const int in_before = pmdrx->eb_in.len;
+    const unsigned char *in_token = pmdrx->eb_in.token;
+
+    struct timespec t0;
+    struct timespec t1;
+    clock_gettime (CLOCK_THREAD_CPUTIME_ID, &t0);
+    const int ret = lws_extension_callback_pm_deflate (context, ext, wsi,
+                                                       reason, user, in, len);
+    clock_gettime (CLOCK_THREAD_CPUTIME_ID, &t1);
+
+    // pm_deflate advances eb_in past consumed input and points eb_out at
+    // its inflate buffer; uncompressed frames are passed through with eb_out
+    // aliasing the input
+    const int consumed = in_before - pmdrx->eb_in.len;
+    const bool inflated = consumed > 0
+                          || (pmdrx->eb_out.token != in_token
+                              && pmdrx->eb_out.len > 0);
+    if (inflated)
+      {
+        conn->stats.inflate_in_bytes += static_cast<uint64_t> (
+            std::max (consumed, 0));
+        conn->stats.inflate_out_bytes += static_cast<uint64_t> (
+            std::max (pmdrx->eb_out.len, 0));
+        conn->stats.inflate_cpu_ms
+            += static_cast<double> (t1.tv_sec - t0.tv_sec) * 1e3
+               + static_cast<double> (t1.tv_nsec - t0.tv_nsec) / 1e6;
+        conn->inflated_current = true;
+      }
+
+    return ret;
+  }
+#endif
+
+  // Callback for the adopted wake-up eventfd
+  static int
+  control_callback (struct lws *wsi, enum lws_callback_reasons reason,
+                    void * /*user*/, void * /*in*/, size_t /*len*/)
+  {
+    Impl *impl = static_cast<Impl *> (lws_context_user (lws_get_context (wsi)));
+    if (impl == nullptr)
+      {
+        return 0;
+      }
+
+    switch (reason)
+      {
+      case LWS_CALLBACK_RAW_RX_FILE:
+        impl->run_control ();
+        break;
+
+      default:
+        break;
+      }
+
+    return 0;
+  }
+
 private:
-  std::string host_;
-  int port_;
-  std::string path_;
+  using Clock = std::chrono::steady_clock;
+
+  struct Connection;
+
+  /**
+   * @brief lws timer with a back pointer (sul must be the first member)
+   */
+  struct ReconnectTimer
+  {
+    lws_sorted_usec_list_t sul;
+    Connection *conn;
+  };
+
+  /**
+   * @brief lws timer driving set_timer() (sul must be the first member)
+   */
+  struct PeriodicTimer
+  {
+    lws_sorted_usec_list_t sul;
+    Impl *owner;
+  };
+
+  /**
+   * @brief Per-target connection state
+   */
+  struct Connection
+  {
+    Impl *owner = nullptr;
+    size_t index = 0;
+    Endpoint endpoint;
+    struct lws *wsi = nullptr;
+    bool connected = false;
+    bool active = false; // Connecting, connected or waiting to reconnect
+    bool lost = false;   // The current attempt's loss was handled
+    std::vector<uint8_t> rx_buffer; // Buffer for fragmented messages
+
+    // Reconnect state
+    ReconnectTimer timer{};
+    uint32_t attempt = 0;
+    bool in_outage = false;
+    bool ever_connected = false;
+    Clock::time_point lost_at;
+    Clock::time_point last_frame_at;
+    bool has_last_frame = false;
+    double frame_interval_s = 0.0; // EWMA of message inter-arrival time
+
+    bool inflated_current = false; // Current message went through inflate
+
+    ConnectionStats stats;
+  };
+
+  void
+  on_established (Connection &conn)
+  {
+    const auto now = Clock::now ();
+    conn.stats.connects++;
+    conn.attempt = 0;
+
+    if (conn.in_outage)
+      {
+        const double outage_ms
+            = std::chrono::duration<double, std::milli> (now - conn.lost_at)
+                  .count ();
+        conn.stats.reconnects++;
+        conn.stats.last_reconnect_ms = outage_ms;
+        conn.stats.max_reconnect_ms
+            = std::max (conn.stats.max_reconnect_ms, outage_ms);
+        conn.stats.total_outage_ms += outage_ms;
+        if (conn.frame_interval_s > 0.0)
+          {
+            conn.stats.estimated_missed_frames += static_cast<uint64_t> (
+                std::llround (outage_ms / 1000.0 / conn.frame_interval_s));
+          }
+        conn.in_outage = false;
+      }
+    conn.ever_connected = true;
+  }
+
+  void
+  on_lost (Connection &conn)
+  {
+    // lws may report a failed attempt both through the callback and by
+    // returning NULL from lws_client_connect_via_info()
+    if (conn.lost)
+      {
+        return;
+      }
+    conn.lost = true;
+    conn.connected = false;
+    conn.rx_buffer.clear ();
+    conn.has_last_frame = false;
+
+    // The outage clock starts when an established connection drops
+    if (conn.ever_connected && !conn.in_outage)
+      {
+        conn.in_outage = true;
+        conn.lost_at = Clock::now ();
+      }
+
+    if (!policy_.enabled || should_disconnect_ || context_ == nullptr)
+      {
+        conn.active = false;
+        return;
+      }
+
+    // Exponential backoff with jitter
+    const double base
+        = std::min (static_cast<double> (policy_.max_delay_ms),
+                    policy_.initial_delay_ms
+                        * std::pow (policy_.multiplier, conn.attempt));
+    const double jitter = std::clamp (policy_.jitter, 0.0, 1.0);
+    std::uniform_real_distribution<double> dist (1.0 - jitter, 1.0);
+    const double delay_ms = base * dist (rng_);
+    conn.attempt++;
+
+    report_status (conn.index,
+                   "Reconnecting in "
+                       + std::to_string (std::llround (delay_ms))
+                       + " ms (attempt " + std::to_string (conn.attempt)
+                       + ")");
+
+    conn.active = true;
+    lws_sul_schedule (context_, 0, &conn.timer.sul, reconnect_timer_cb,
+                      static_cast<lws_usec_t> (delay_ms * 1000.0));
+  }
+
+  static void
+  reconnect_timer_cb (lws_sorted_usec_list_t *sul)
+  {
+    // sul is the first member of ReconnectTimer
+    auto *timer = reinterpret_cast<ReconnectTimer *> (sul);
+    Connection &conn = *timer->conn;
+    if (conn.owner->should_disconnect_)
+      {
+        conn.active = false;
+        return;
+      }
+    conn.owner->connect_one (conn);
+  }
+
+  void
+  schedule_timer ()
+  {
+    if (!timer_callback_ || timer_interval_.count () <= 0)
+      {
+        return;
+      }
+    timer_.owner = this;
+    lws_sul_schedule (context_, 0, &timer_.sul, periodic_timer_cb,
+                      static_cast<lws_usec_t> (timer_interval_.count ())
+                          * 1000);
+  }
+
+  static void
+  periodic_timer_cb (lws_sorted_usec_list_t *sul)
+  {
+    // sul is the first member of PeriodicTimer
+    Impl &owner = *reinterpret_cast<PeriodicTimer *> (sul)->owner;
+    if (owner.should_disconnect_)
+      {
+        return;
+      }
+    owner.timer_callback_ ();
+    owner.schedule_timer ();
+  }
+
+  bool
+  connect_one (Connection &conn)
+  {
+    // Setup connection info
+    struct lws_client_connect_info ccinfo;
+    std::memset (&ccinfo, 0, sizeof (ccinfo));
+
+    ccinfo.context = context_;
+    ccinfo.address = conn.endpoint.host.c_str ();
+    ccinfo.port = conn.endpoint.port;
+    ccinfo.path = conn.endpoint.path.c_str ();
+    ccinfo.host = conn.endpoint.host.c_str ();
+    ccinfo.origin = conn.endpoint.host.c_str ();
+    ccinfo.protocol = "binary"; // Use binary protocol
+    if (conn.endpoint.use_tls)
+      {
+        ccinfo.ssl_connection = LCCSCF_USE_SSL
+                                | LCCSCF_ALLOW_SELFSIGNED
+                                | LCCSCF_SKIP_SERVER_CERT_HOSTNAME_CHECK
+                                | LCCSCF_ALLOW_EXPIRED
+                                | LCCSCF_ALLOW_INSECURE;
+      }
+    ccinfo.userdata = &conn;
+
+    conn.active = true;
+    conn.lost = false;
+    conn.wsi = lws_client_connect_via_info (&ccinfo);
+    if (conn.wsi == nullptr)
+      {
+        // Immediate failures already went through CONNECTION_ERROR
+        if (!conn.lost)
+          {
+            report_error (conn.index, "Failed to initiate connection");
+            conn.stats.failed_attempts++;
+            on_lost (conn);
+          }
+        return false;
+      }
+
+    return true;
+  }
+
+  void
+  receive (Connection &conn, struct lws *wsi, const uint8_t *data, size_t len)
+  {
+    // lws delivers large messages in rx_buffer_size chunks and reports the
+    // final chunk of the final fragment via lws_is_final_fragment()
+    const bool is_final = lws_is_final_fragment (wsi) != 0;
+
+    if (is_final)
+      {
+        count_message (conn, conn.rx_buffer.size () + len);
+      }
+
+    if (is_final && conn.rx_buffer.empty ())
+      {
+        // Common case: whole message in one chunk, no copy
+        message_callback_ (conn.index, data, len);
+        return;
+      }
+
+    conn.rx_buffer.insert (conn.rx_buffer.end (), data, data + len);
+
+    if (is_final)
+      {
+        message_callback_ (conn.index, conn.rx_buffer.data (),
+                           conn.rx_buffer.size ());
+        conn.rx_buffer.clear ();
+      }
+  }
+
+  bool
+  adopt_wake_fd ()
+  {
+    if (wake_fd_ < 0)
+      {
+        return false;
+      }
+
+    // lws closes adopted descriptors itself, so give it a duplicate
+    lws_sock_file_fd_type fd;
+    fd.filefd = dup (wake_fd_);
+    if (fd.filefd < 0)
+      {
+        return false;
+      }
+
+    struct lws_vhost *vhost = lws_get_vhost_by_name (context_, "default");
+    struct lws *wsi
+        = vhost != nullptr
+              ? lws_adopt_descriptor_vhost (vhost, LWS_ADOPT_RAW_FILE_DESC, fd,
+                                            "jettison-control", nullptr)
+              : nullptr;
+    if (wsi == nullptr)
+      {
+        close (fd.filefd);
+        return false;
+      }
+    return true;
+  }
+
+  // Async-signal-safe: never calls into libwebsockets
+  void
+  wake ()
+  {
+    if (wake_fd_ >= 0)
+      {
+        const uint64_t one = 1;
+        const ssize_t n = write (wake_fd_, &one, sizeof (one));
+        (void) n; // Counter overflow just means a wake-up is already pending
+      }
+  }
+
+  void
+  run_control ()
+  {
+    uint64_t value = 0;
+    while (wake_fd_ >= 0 && read (wake_fd_, &value, sizeof (value)) > 0)
+      {
+        // Drain the eventfd counter
+      }
+
+    std::deque<std::function<void ()>> commands;
+    {
+      std::lock_guard<std::mutex> lock (commands_mutex_);
+      commands.swap (commands_);
+    }
+    for (auto &command : commands)
+      {
+        command ();
+      }
+  }
+
+  static std::string
+  build_deflate_offer (const DeflateOptions &options)
+  {
+    std::string offer = "permessage-deflate";
+    if (options.server_max_window_bits > 0)
+      {
+        offer += "; server_max_window_bits="
+                 + std::to_string (options.server_max_window_bits);
+      }
+    offer += "; client_max_window_bits";
+    if (options.client_max_window_bits > 0)
+      {
+        offer += "=" + std::to_string (options.client_max_window_bits);
+      }
+    if (options.server_no_context_takeover)
+      {
+        offer += "; server_no_context_takeover";
+      }
+    if (options.client_no_context_takeover)
+      {
+        offer += "; client_no_context_takeover";
+      }
+    return offer;
+  }
+
+  static void
+  count_message (Connection &conn, size_t len)
+  {
+    const auto now = Clock::now ();
+    conn.stats.messages++;
+    conn.stats.bytes += len;
+    if (conn.inflated_current)
+      {
+        conn.stats.compressed_messages++;
+        conn.inflated_current = false;
+      }
+
+    if (conn.has_last_frame)
+      {
+        const double dt
+            = std::chrono::duration<double> (now - conn.last_frame_at).count ();
+        conn.frame_interval_s = conn.frame_interval_s > 0.0
+                                    ? 0.9 * conn.frame_interval_s + 0.1 * dt
+                                    : dt;
+      }
+    conn.last_frame_at = now;
+    conn.has_last_frame = true;
+  }
+
+  bool
+  any_active () const
+  {
+    for (const auto &conn : connections_)
+      {
+        if (conn->active)
+          {
+            return true;
+          }
+      }
+    return false;
+  }
+
+  void
+  report_error (size_t target, const std::string &error)
+  {
+    if (error_callback_)
+      {
+        error_callback_ (target, error);
+      }
+  }
+
+  void
+  report_status (size_t target, const std::string &message)
+  {
+    if (status_callback_)
+      {
+        status_callback_ (target, message);
+      }
+  }
 
   struct lws_context *context_;
-  struct lws *wsi_;
+  std::atomic<bool> should_disconnect_;
+
+  std::vector<std::unique_ptr<Connection>> connections_;
+  ReconnectPolicy policy_;
+  std::mt19937 rng_; // Backoff jitter
+
+  DeflateOptions deflate_;
+  std::string deflate_offer_;         // Must outlive the context
+  struct lws_extension extensions_[2]{};
 
-  bool connected_;
-  bool should_disconnect_;
+  int wake_fd_; // eventfd in the lws event loop, see wake()
+  std::mutex commands_mutex_;
+  std::deque<std::function<void ()>> commands_;
+
+  PeriodicTimer timer_{}; // See set_timer()
+  std::chrono::milliseconds timer_interval_{ 0 };
+  std::function<void ()> timer_callback_;
 
   MessageCallback message_callback_;
   ConnectionCallback connection_callback_;
   ErrorCallback error_callback_;
-
-  std::vector<uint8_t> rx_buffer_; // Buffer for fragmented messages
+  StatusCallback status_callback_;
 
   static constexpr struct lws_protocols protocols_[]
       = { { "binary", callback_function, 0, 4096, 0, nullptr, 0 },
+          { "jettison-control", control_callback, 0, 0, 0, nullptr, 0 },
           { nullptr, nullptr, 0, 0, 0, nullptr, 0 } };
 };
 
@@ -250,14 +878,74 @@ constexpr struct lws_protocols WebSocketClient::Impl::protocols_[];
 
 // WebSocketClient implementation (forwarding to Impl)
 
+WebSocketClient::WebSocketClient () : pimpl_ (std::make_unique<Impl> ()) {}
+
 WebSocketClient::WebSocketClient (const std::string &host, int port,
                                   const std::string &path)
-    : pimpl_ (std::make_unique<Impl> (host, port, path))
+    : pimpl_ (std::make_unique<Impl> ())
 {
+  Endpoint endpoint;
+  endpoint.host = host;
+  endpoint.port = port;
+  endpoint.path = path;
+  pimpl_->add_target (endpoint);
 }
 
 WebSocketClient::~WebSocketClient () = default;
 
+size_t
+WebSocketClient::add_target (const Endpoint &endpoint)
+{
+  return pimpl_->add_target (endpoint);
+}
+
+size_t
+WebSocketClient::target_count () const
+{
+  return pimpl_->target_count ();
+}
+
+const Endpoint &
+WebSocketClient::get_target (size_t target) const
+{
+  return pimpl_->get_target (target);
+}
+
+bool
+WebSocketClient::deflate_supported ()
+{
+#if !defined(LWS_WITHOUT_EXTENSIONS)
+  return true;
+#else
+  return false;
+#endif
+}
+
+void
+WebSocketClient::set_deflate_options (const DeflateOptions &options)
+{
+  pimpl_->set_deflate_options (options);
+}
+
+void
+WebSocketClient::set_reconnect_policy (const ReconnectPolicy &policy)
+{
+  pimpl_->set_reconnect_policy (policy);
+}
+
+void
+WebSocketClient::set_timer (std::chrono::milliseconds interval,
+                            std::function<void ()> callback)
+{
+  pimpl_->set_timer (interval, std::move (callback));
+}
+
+ConnectionStats
+WebSocketClient::get_stats (size_t target) const
+{
+  return pimpl_->get_stats (target);
+}
+
 void
 WebSocketClient::set_message_callback (MessageCallback callback)
 {
@@ -276,6 +964,12 @@ WebSocketClient::set_error_callback (ErrorCallback callback)
   pimpl_->set_error_callback (std::move (callback));
 }
 
+void
+WebSocketClient::set_status_callback (StatusCallback callback)
+{
+  pimpl_->set_status_callback (std::move (callback));
+}
+
 bool
 WebSocketClient::connect ()
 {
@@ -294,10 +988,22 @@ WebSocketClient::disconnect ()
   pimpl_->disconnect ();
 }
 
+void
+WebSocketClient::post (std::function<void ()> command)
+{
+  pimpl_->post (std::move (command));
+}
+
 bool
 WebSocketClient::is_connected () const
 {
   return pimpl_->is_connected ();
 }
 
+size_t
+WebSocketClient::connected_count () const
+{
+  return pimpl_->connected_count ();
+}
+
 } // namespace jettison
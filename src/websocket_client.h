@@ -4,10 +4,12 @@
 #ifndef WEBSOCKET_CLIENT_H
 #define WEBSOCKET_CLIENT_H
 
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <optional>
 #include <string>
 
 struct lws_context;
@@ -16,21 +18,122 @@ struct lws;
 namespace jettison
 {
 
+/**
+ * @brief A WebSocket endpoint to connect to
+ */
+struct Endpoint
+{
+  std::string host;
+  int port = 443;
+  std::string path = "/ws/ws_state";
+  bool use_tls = true;
+
+  /**
+   * @brief Format as a URI (e.g., "wss://sych.local:443/ws/ws_state")
+   * @return URI string
+   */
+  std::string to_uri () const;
+};
+
+/**
+ * @brief Parse an endpoint specification
+ *
+ * Accepts a bare host ("sych.local"), host and port ("10.0.0.5:8443"),
+ * or a full URI ("ws://127.0.0.1:8765/ws/ws_state"). Missing parts
+ * default to wss, port 443 and path /ws/ws_state.
+ *
+ * @param spec Endpoint specification
+ * @return Parsed endpoint, or nullopt if the specification is malformed
+ */
+std::optional<Endpoint> parse_endpoint (const std::string &spec);
+
+/**
+ * @brief Automatic reconnect behaviour
+ *
+ * After a connection error or close, the client waits
+ * min(max_delay_ms, initial_delay_ms * multiplier^attempt), reduced by a
+ * random fraction of up to `jitter`, then reconnects on the same context
+ * (so TLS sessions can be resumed).
+ */
+struct ReconnectPolicy
+{
+  bool enabled = false;
+  uint32_t initial_delay_ms = 250;
+  uint32_t max_delay_ms = 30000;
+  double multiplier = 2.0;
+  double jitter = 0.3; // 0 = fixed delays, 1 = anywhere in [0, delay]
+};
+
+/**
+ * @brief permessage-deflate (RFC 7692) negotiation settings
+ *
+ * Window sizes of 0 leave the parameter to the server. A smaller
+ * server_max_window_bits reduces inflate memory on this side at some cost
+ * in compression ratio; no_context_takeover trades ratio for memory too.
+ */
+struct DeflateOptions
+{
+  bool enabled = false;
+  int server_max_window_bits = 0; // 8..15, 0 = server's choice
+  int client_max_window_bits = 0; // 8..15, 0 = offered without a value
+  bool server_no_context_takeover = false;
+  bool client_no_context_takeover = false;
+};
+
+/**
+ * @brief Connection counters for one target
+ */
+struct ConnectionStats
+{
+  uint64_t connects = 0;         // Successful handshakes (incl. first)
+  uint64_t reconnects = 0;       // Successful handshakes after a loss
+  uint64_t disconnects = 0;      // Established connections that closed
+  uint64_t failed_attempts = 0;  // Connection attempts that failed
+  uint64_t messages = 0;         // Complete messages received
+  uint64_t bytes = 0;            // Payload bytes received
+  double last_reconnect_ms = 0;  // Loss -> re-established, last outage
+  double max_reconnect_ms = 0;   // Longest outage
+  double total_outage_ms = 0;    // Sum of all outages
+  uint64_t estimated_missed_frames = 0; // Outage time / frame interval
+
+  // permessage-deflate accounting (zero unless negotiated)
+  bool deflate_offered = false; // Requested and supported by libwebsockets
+  bool deflate_negotiated = false;
+  uint64_t compressed_messages = 0; // Messages that went through inflate
+  uint64_t inflate_in_bytes = 0;    // Compressed bytes fed to inflate
+  uint64_t inflate_out_bytes = 0;   // Decompressed bytes produced
+  double inflate_cpu_ms = 0;        // Thread CPU time spent inflating
+};
+
 /**
  * @brief WebSocket client for receiving binary state messages
  *
- * This client connects to a WebSocket endpoint over WSS (TLS),
- * ignoring certificate validation errors for local/development use.
+ * This client connects to one or more WebSocket endpoints over WSS (TLS)
+ * or plain WS, ignoring certificate validation errors for
+ * local/development use. All connections share a single libwebsockets
+ * context and are serviced from one event loop.
  */
 class WebSocketClient
 {
 public:
-  using MessageCallback = std::function<void (const uint8_t *data, size_t len)>;
-  using ConnectionCallback = std::function<void (bool connected)>;
-  using ErrorCallback = std::function<void (const std::string &error)>;
+  using MessageCallback
+      = std::function<void (size_t target, const uint8_t *data, size_t len)>;
+  using ConnectionCallback
+      = std::function<void (size_t target, bool connected)>;
+  using ErrorCallback
+      = std::function<void (size_t target, const std::string &error)>;
+  using StatusCallback
+      = std::function<void (size_t target, const std::string &message)>;
+
+  /**
+   * @brief Construct a WebSocket client with no targets
+   *
+   * Add targets with add_target() before calling connect().
+   */
+  WebSocketClient ();
 
   /**
-   * @brief Construct a WebSocket client
+   * @brief Construct a WebSocket client for a single WSS target
    * @param host Hostname or IP address (e.g., "sych.local")
    * @param port Port number (default 443 for HTTPS/WSS)
    * @param path WebSocket path (e.g., "/ws/ws_state")
@@ -44,9 +147,30 @@ public:
   WebSocketClient (WebSocketClient &&) = delete;
   WebSocketClient &operator= (WebSocketClient &&) = delete;
 
+  /**
+   * @brief Add a target endpoint
+   * @param endpoint Endpoint to connect to
+   * @return Target index passed to callbacks for this endpoint
+   */
+  size_t add_target (const Endpoint &endpoint);
+
+  /**
+   * @brief Get the number of targets
+   * @return Target count
+   */
+  size_t target_count () const;
+
+  /**
+   * @brief Get the endpoint of a target
+   * @param target Target index
+   * @return Endpoint
+   */
+  const Endpoint &get_target (size_t target) const;
+
   /**
    * @brief Set callback for received messages
-   * @param callback Function called when binary message is received
+   * @param callback Function called when a complete binary message is
+   *                 received; data is only valid during the call
    */
   void set_message_callback (MessageCallback callback);
 
@@ -63,15 +187,76 @@ public:
   void set_error_callback (ErrorCallback callback);
 
   /**
-   * @brief Connect to the WebSocket server
-   * @return true if connection initiated successfully
+   * @brief Set callback for informational state changes
+   * @param callback Function called e.g. when a reconnect is scheduled
+   */
+  void set_status_callback (StatusCallback callback);
+
+  /**
+   * @brief Set the reconnect policy (disabled by default)
+   * @param policy Reconnect policy applied to all targets
+   */
+  void set_reconnect_policy (const ReconnectPolicy &policy);
+
+  /**
+   * @brief Check whether libwebsockets was built with permessage-deflate
+   *
+   * Without it (LWS_WITHOUT_EXTENSIONS), deflate options are ignored and
+   * connections are uncompressed.
+   *
+   * @return true if deflate can be offered
+   */
+  static bool deflate_supported ();
+
+  /**
+   * @brief Set permessage-deflate options (disabled by default)
+   *
+   * Must be called before connect().
+   *
+   * @param options Deflate negotiation settings for all targets
+   */
+  void set_deflate_options (const DeflateOptions &options);
+
+  /**
+   * @brief Run a callback periodically on the event loop thread
+   *
+   * Must be called before connect(). The timer runs while run() does,
+   * whether or not frames arrive; only one timer can be set.
+   *
+   * @param interval Time between calls
+   * @param callback Function called on every expiry
+   */
+  void set_timer (std::chrono::milliseconds interval,
+                  std::function<void ()> callback);
+
+  /**
+   * @brief Get connection counters for a target
+   *
+   * Only call from the event loop thread or after run() returned.
+   *
+   * @param target Target index
+   * @return Connection statistics
+   */
+  ConnectionStats get_stats (size_t target) const;
+
+  /**
+   * @brief Connect to all targets
+   *
+   * Fails outright if the wake-up eventfd used by disconnect() and post()
+   * cannot be added to the event loop.
+   *
+   * @return true if at least one connection was initiated successfully,
+   *         or a retry is scheduled (reconnect enabled)
    */
   bool connect ();
 
   /**
    * @brief Run the event loop (blocking)
    *
-   * This will process WebSocket events until disconnect or error.
+   * This will process WebSocket events until disconnect() is called or
+   * every connection has closed for good (i.e., with reconnect disabled).
+   * The loop sleeps until there is socket activity, a timer, or a wake-up
+   * from disconnect()/post(); it uses no CPU while idle.
    * Call this after connect().
    */
   void run ();
@@ -79,16 +264,34 @@ public:
   /**
    * @brief Request disconnection
    *
-   * Can be called from callbacks to stop the event loop.
+   * Stops the event loop immediately. Async-signal-safe and thread-safe
+   * (an atomic store plus a write to an eventfd), so it can be called
+   * from callbacks, other threads, or signal handlers.
    */
   void disconnect ();
 
   /**
-   * @brief Check if currently connected
+   * @brief Run a command on the event loop thread
+   *
+   * Thread-safe (but not async-signal-safe). The loop is woken up and
+   * runs queued commands in order before servicing further events.
+   *
+   * @param command Function to run on the event loop thread
+   */
+  void post (std::function<void ()> command);
+
+  /**
+   * @brief Check if any target is currently connected
    * @return true if connected
    */
   bool is_connected () const;
 
+  /**
+   * @brief Get the number of currently connected targets
+   * @return Connected target count
+   */
+  size_t connected_count () const;
+
 private:
   class Impl;
   std::unique_ptr<Impl> pimpl_;
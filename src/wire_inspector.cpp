@@ -0,0 +1,453 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 Jettison Project Team
+
+#include "wire_inspector.h"
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+
+namespace jettison
+{
+
+using google::protobuf::Descriptor;
+using google::protobuf::FieldDescriptor;
+
+namespace
+{
+
+enum class VarintStatus
+{
+  Ok,
+  Short, // Ran out of bytes
+  Long   // More than 10 bytes
+};
+
+VarintStatus
+read_varint (const uint8_t *data, uint32_t &p, uint32_t end, uint64_t &value)
+{
+  value = 0;
+  for (unsigned shift = 0; shift < 70; shift += 7)
+    {
+      if (p >= end)
+        {
+          return VarintStatus::Short;
+        }
+      const uint8_t byte = data[p++];
+      if (shift < 64)
+        {
+          value |= static_cast<uint64_t> (byte & 0x7F) << shift;
+        }
+      if ((byte & 0x80) == 0)
+        {
+          return VarintStatus::Ok;
+        }
+    }
+  return VarintStatus::Long;
+}
+
+/**
+ * @brief Wire type a field is serialized with (packed repeated scalars
+ * may also use 2)
+ */
+int
+declared_wire_type (const FieldDescriptor *field)
+{
+  switch (field->type ())
+    {
+    case FieldDescriptor::TYPE_DOUBLE:
+    case FieldDescriptor::TYPE_FIXED64:
+    case FieldDescriptor::TYPE_SFIXED64:
+      return 1;
+    case FieldDescriptor::TYPE_FLOAT:
+    case FieldDescriptor::TYPE_FIXED32:
+    case FieldDescriptor::TYPE_SFIXED32:
+      return 5;
+    case FieldDescriptor::TYPE_STRING:
+    case FieldDescriptor::TYPE_BYTES:
+    case FieldDescriptor::TYPE_MESSAGE:
+      return 2;
+    case FieldDescriptor::TYPE_GROUP:
+      return 3;
+    default:
+      return 0;
+    }
+}
+
+/**
+ * @brief Recursive walk over one message's fields
+ */
+class Walker
+{
+public:
+  Walker (const uint8_t *data, uint32_t len, WireScan &scan, bool record)
+      : data_ (data), len_ (len), scan_ (scan), record_ (record)
+  {
+  }
+
+  bool
+  walk (uint32_t begin, uint32_t end, const Descriptor *type,
+        const FieldPath &parent)
+  {
+    uint32_t p = begin;
+    while (p < end)
+      {
+        const uint32_t tag_offset = p;
+        uint64_t tag = 0;
+        if (!varint (p, end, tag, tag_offset, parent))
+          {
+            return false;
+          }
+
+        const auto number = static_cast<int32_t> (tag >> 3);
+        const auto wire_type = static_cast<uint8_t> (tag & 7);
+        if (number == 0 || (tag >> 3) > 536870911)
+          {
+            return fail (WireError::BadFieldNumber, tag_offset, parent);
+          }
+        FieldPath path = parent;
+        path.push (number);
+        const FieldDescriptor *field
+            = type != nullptr ? type->FindFieldByNumber (number) : nullptr;
+
+        uint32_t value_offset = p;
+        uint64_t value = 0;
+        switch (wire_type)
+          {
+          case 0:
+            if (!varint (p, end, value, tag_offset, path))
+              {
+                return false;
+              }
+            break;
+          case 1:
+          case 5:
+            {
+              const uint32_t size = wire_type == 1 ? 8 : 4;
+              if (end - p < size)
+                {
+                  return fail (end == len_ ? WireError::Truncated
+                                           : WireError::LengthOverflow,
+                               tag_offset, path);
+                }
+              p += size;
+              break;
+            }
+          case 2:
+            if (!varint (p, end, value, tag_offset, path))
+              {
+                return false;
+              }
+            if (value > end - p)
+              {
+                if (value > len_ - p && end == len_ && descends (field, path))
+                  {
+                    // Cut inside a sub-message: find the field it cut
+                    // through, if the cut is not on a field boundary
+                    const size_t recorded = scan_.fields.size ();
+                    if (!walk (p, len_, field->message_type (), path))
+                      {
+                        return false;
+                      }
+                    scan_.fields.resize (recorded);
+                  }
+                return fail (value > len_ - p ? WireError::Truncated
+                                              : WireError::LengthOverflow,
+                             tag_offset, path);
+              }
+            value_offset = p;
+            p += static_cast<uint32_t> (value);
+            break;
+          default:
+            return fail (WireError::BadWireType, tag_offset, path);
+          }
+
+        if (field != nullptr && wire_type != declared_wire_type (field)
+            && !(wire_type == 2 && field->is_packable ()))
+          {
+            return fail (WireError::WrongWireType, tag_offset, path);
+          }
+
+        scan_.field_count++;
+        if (record_)
+          {
+            scan_.fields.push_back (
+                WireField{ path, field, tag_offset, value_offset, p,
+                           wire_type });
+          }
+
+        if (wire_type == 2 && descends (field, path)
+            && !walk (value_offset, p, field->message_type (), path))
+          {
+            return false;
+          }
+      }
+    return true;
+  }
+
+private:
+  /**
+   * @brief Strings, bytes and packed scalars are leaves; so is anything
+   * nested deeper than a FieldPath can name
+   */
+  static bool
+  descends (const FieldDescriptor *field, const FieldPath &path)
+  {
+    return field != nullptr
+           && field->type () == FieldDescriptor::TYPE_MESSAGE
+           && path.depth < FieldPath::MAX_DEPTH;
+  }
+
+  bool
+  varint (uint32_t &p, uint32_t end, uint64_t &value, uint32_t start,
+          const FieldPath &path)
+  {
+    switch (read_varint (data_, p, end, value))
+      {
+      case VarintStatus::Short:
+        return fail (end == len_ ? WireError::Truncated
+                                 : WireError::LengthOverflow,
+                     start, path);
+      case VarintStatus::Long:
+        return fail (WireError::BadVarint, start, path);
+      case VarintStatus::Ok:
+      default:
+        return true;
+      }
+  }
+
+  bool
+  fail (WireError error, uint32_t offset, const FieldPath &path)
+  {
+    scan_.error = error;
+    scan_.error_offset = offset;
+    scan_.error_path = path;
+    return false;
+  }
+
+  const uint8_t *data_;
+  uint32_t len_;
+  WireScan &scan_;
+  bool record_;
+};
+
+/**
+ * @brief Read a little-endian fixed-width value
+ */
+template <typename T>
+T
+load (const uint8_t *data)
+{
+  T value;
+  std::memcpy (&value, data, sizeof (value));
+  return value;
+}
+
+} // namespace
+
+const char *
+wire_error_name (WireError error)
+{
+  switch (error)
+    {
+    case WireError::Truncated:
+      return "truncated";
+    case WireError::BadVarint:
+      return "varint longer than 10 bytes";
+    case WireError::BadFieldNumber:
+      return "invalid field number";
+    case WireError::BadWireType:
+      return "invalid wire type";
+    case WireError::LengthOverflow:
+      return "field overruns its parent message";
+    case WireError::WrongWireType:
+      return "wire type does not match the declared type";
+    case WireError::None:
+    default:
+      return "OK";
+    }
+}
+
+bool
+WireInspector::scan (const uint8_t *data, size_t len, WireScan &scan,
+                     bool record_fields)
+{
+  scan.fields.clear ();
+  scan.field_count = 0;
+  scan.error = WireError::None;
+  scan.error_offset = 0;
+  scan.error_path = FieldPath{};
+
+  const auto length
+      = static_cast<uint32_t> (std::min<size_t> (len, UINT32_MAX));
+  Walker walker (data, length, scan, record_fields);
+  return walker.walk (0, length, ser::JonGUIState::descriptor (),
+                      FieldPath{});
+}
+
+const WireField *
+WireInspector::field_at (const WireScan &scan, size_t offset)
+{
+  // Pre-order, so the last field containing the byte is the innermost
+  const WireField *found = nullptr;
+  for (const auto &field : scan.fields)
+    {
+      if (field.offset > offset)
+        {
+          break;
+        }
+      if (offset < field.end)
+        {
+          found = &field;
+        }
+    }
+  return found;
+}
+
+std::string
+WireInspector::format_value (const WireField &field, const uint8_t *data)
+{
+  std::ostringstream out;
+  out.precision (10);
+  const FieldDescriptor *descriptor = field.descriptor;
+  const uint8_t *value = data + field.value_offset;
+  const size_t size = field.end - field.value_offset;
+
+  switch (field.wire_type)
+    {
+    case 0:
+      {
+        uint32_t p = field.value_offset;
+        uint64_t raw = 0;
+        read_varint (data, p, field.end, raw);
+        switch (descriptor != nullptr ? descriptor->type ()
+                                      : FieldDescriptor::TYPE_UINT64)
+          {
+          case FieldDescriptor::TYPE_BOOL:
+            out << (raw != 0 ? "true" : "false");
+            break;
+          case FieldDescriptor::TYPE_INT32:
+            out << static_cast<int32_t> (raw);
+            break;
+          case FieldDescriptor::TYPE_INT64:
+            out << static_cast<int64_t> (raw);
+            break;
+          case FieldDescriptor::TYPE_SINT32:
+          case FieldDescriptor::TYPE_SINT64:
+            out << (static_cast<int64_t> (raw >> 1)
+                    ^ -static_cast<int64_t> (raw & 1));
+            break;
+          case FieldDescriptor::TYPE_ENUM:
+            {
+              const auto *enum_value
+                  = descriptor->enum_type ()->FindValueByNumber (
+                      static_cast<int> (raw));
+              if (enum_value != nullptr)
+                {
+                  out << enum_value->name ();
+                }
+              else
+                {
+                  out << static_cast<int32_t> (raw) << " (unknown enum)";
+                }
+              break;
+            }
+          default:
+            out << raw;
+            break;
+          }
+        break;
+      }
+    case 1:
+      if (descriptor != nullptr
+          && descriptor->type () == FieldDescriptor::TYPE_DOUBLE)
+        {
+          out << load<double> (value);
+        }
+      else if (descriptor != nullptr
+               && descriptor->type () == FieldDescriptor::TYPE_SFIXED64)
+        {
+          out << load<int64_t> (value);
+        }
+      else
+        {
+          out << load<uint64_t> (value);
+        }
+      break;
+    case 5:
+      if (descriptor != nullptr
+          && descriptor->type () == FieldDescriptor::TYPE_FLOAT)
+        {
+          out << static_cast<double> (load<float> (value));
+        }
+      else if (descriptor != nullptr
+               && descriptor->type () == FieldDescriptor::TYPE_SFIXED32)
+        {
+          out << load<int32_t> (value);
+        }
+      else
+        {
+          out << load<uint32_t> (value);
+        }
+      break;
+    default:
+      if (descriptor != nullptr
+          && descriptor->type () == FieldDescriptor::TYPE_STRING)
+        {
+          constexpr size_t SHOWN = 40;
+          out << '"';
+          for (size_t i = 0; i < std::min (size, SHOWN); ++i)
+            {
+              const auto c = static_cast<char> (value[i]);
+              out << (value[i] >= 0x20 && value[i] < 0x7F ? c : '?');
+            }
+          out << (size > SHOWN ? "\"..." : "\"");
+        }
+      else if (descriptor != nullptr
+               && descriptor->type () == FieldDescriptor::TYPE_MESSAGE)
+        {
+          out << "{" << size << " bytes}";
+        }
+      else
+        {
+          out << size << " bytes";
+        }
+      break;
+    }
+  return out.str ();
+}
+
+std::string
+WireInspector::describe_error (const WireScan &scan)
+{
+  if (scan.error == WireError::None)
+    {
+      return "OK";
+    }
+
+  std::ostringstream out;
+  out << wire_error_name (scan.error) << " at byte " << scan.error_offset
+      << " in " << scan.error_path.to_string ();
+  return out.str ();
+}
+
+WireDiff
+diff_wire (const uint8_t *a, size_t a_len, const WireScan &a_scan,
+           const uint8_t *b, size_t b_len, const WireScan &b_scan)
+{
+  WireDiff diff;
+  const size_t common = std::min (a_len, b_len);
+  const size_t offset = static_cast<size_t> (
+      std::mismatch (a, a + common, b).first - a);
+  if (offset == common && a_len == b_len)
+    {
+      return diff;
+    }
+
+  diff.identical = false;
+  diff.offset = offset;
+  diff.a = WireInspector::field_at (a_scan, offset);
+  diff.b = WireInspector::field_at (b_scan, offset);
+  return diff;
+}
+
+} // namespace jettison
@@ -0,0 +1,145 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 Jettison Project Team
+
+#ifndef WIRE_INSPECTOR_H
+#define WIRE_INSPECTOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "violation.h"
+
+namespace jettison
+{
+
+/**
+ * @brief First wire-format problem found in a payload
+ */
+enum class WireError : uint8_t
+{
+  None,
+  Truncated,      // A tag, value or length-delimited field runs past the
+                  // end of the payload
+  BadVarint,      // Varint longer than 10 bytes
+  BadFieldNumber, // Tag with field number 0
+  BadWireType,    // Wire type 3, 4, 6 or 7 (groups are not used)
+  LengthOverflow, // Length-delimited field runs past its parent message
+  WrongWireType   // Known field encoded with another wire type than its
+                  // declared type (parsed as an unknown field)
+};
+
+/**
+ * @brief Get a short description of a wire error
+ * @param error Error kind
+ * @return e.g. "truncated"
+ */
+const char *wire_error_name (WireError error);
+
+/**
+ * @brief One tag/value pair found in a payload
+ */
+struct WireField
+{
+  FieldPath path;        // Field numbers from the root message
+  const google::protobuf::FieldDescriptor *descriptor; // nullptr = unknown
+  uint32_t offset;       // First byte of the tag
+  uint32_t value_offset; // First byte of the value (after any length)
+  uint32_t end;          // One past the last byte of the value
+  uint8_t wire_type;     // 0 varint, 1 fixed64, 2 length-delimited,
+                         // 5 fixed32
+};
+
+/**
+ * @brief Result of walking a payload's wire format
+ */
+struct WireScan
+{
+  std::vector<WireField> fields; // Pre-order: each sub-message before its
+                                 // fields (empty unless requested)
+  size_t field_count = 0;        // Tags read, whether recorded or not
+  WireError error = WireError::None;
+  uint32_t error_offset = 0;     // Byte where the bad tag or value starts
+  FieldPath error_path;          // Field being read (its parents if the
+                                 // tag itself is unreadable)
+};
+
+/**
+ * @brief Walks the raw protobuf wire format of a JonGUIState payload
+ *
+ * Reads tags and values without building a message, resolving each field
+ * number against the jon_shared_data descriptors and descending into
+ * sub-messages, so it can say where a payload that fails
+ * ParseFromArray() breaks: the byte offset and field path of the first
+ * truncation, bad varint or bad tag. Without recording fields a scan
+ * costs about as much as a parse and never allocates, which is enough to
+ * sweep thousands of dumps for a common corruption point. Stateless and
+ * thread-safe.
+ */
+class WireInspector
+{
+public:
+  /**
+   * @brief Walk a payload up to its end or first error
+   * @param data Payload
+   * @param len Payload length in bytes
+   * @param scan Receives the result (reset first; fields kept allocated)
+   * @param record_fields Fill scan.fields
+   * @return true if the whole payload is well-formed
+   */
+  static bool scan (const uint8_t *data, size_t len, WireScan &scan,
+                    bool record_fields = true);
+
+  /**
+   * @brief Find the innermost recorded field containing a byte
+   * @param scan Scan with fields recorded
+   * @param offset Byte offset
+   * @return Field, or nullptr if the byte is outside every field
+   */
+  static const WireField *field_at (const WireScan &scan, size_t offset);
+
+  /**
+   * @brief Format a field's value according to its declared type
+   * @param field Field from a scan of data
+   * @param data Payload the field was read from
+   * @return e.g. "12.5", "true", "\"abc\"", "{48 bytes}"
+   */
+  static std::string format_value (const WireField &field,
+                                   const uint8_t *data);
+
+  /**
+   * @brief Describe a scan's error in one line
+   * @param scan Scan result
+   * @return e.g. "truncated at byte 1043 in gps.longitude", or "OK"
+   */
+  static std::string describe_error (const WireScan &scan);
+};
+
+/**
+ * @brief Where two payloads first differ
+ */
+struct WireDiff
+{
+  bool identical = true;
+  size_t offset = 0;               // First differing byte
+  const WireField *a = nullptr;    // Innermost field at offset in a
+  const WireField *b = nullptr;    // Innermost field at offset in b
+};
+
+/**
+ * @brief Locate the first differing byte of two scanned payloads
+ * @param a First payload
+ * @param a_len First payload length
+ * @param a_scan Scan of a with fields recorded
+ * @param b Second payload
+ * @param b_len Second payload length
+ * @param b_scan Scan of b with fields recorded
+ * @return First divergence (pointers into the scans)
+ */
+WireDiff diff_wire (const uint8_t *a, size_t a_len, const WireScan &a_scan,
+                    const uint8_t *b, size_t b_len, const WireScan &b_scan);
+
+} // namespace jettison
+
+#endif // WIRE_INSPECTOR_H
@@ -0,0 +1,111 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 Jettison Project Team
+
+#include "worker_pool.h"
+#include <utility>
+
+namespace jettison
+{
+
+WorkerPool::WorkerPool (size_t threads, size_t queue_capacity,
+                        ThreadInit init)
+    : init_ (std::move (init)), queue_capacity_ (queue_capacity),
+      stopping_ (false), dropped_ (0)
+{
+  if (threads == 0)
+    {
+      threads = 1;
+    }
+
+  workers_.reserve (threads);
+  for (size_t i = 0; i < threads; ++i)
+    {
+      workers_.push_back (std::make_unique<Worker> ());
+    }
+
+  // Start threads only once all workers exist
+  for (size_t i = 0; i < threads; ++i)
+    {
+      workers_[i]->thread = std::thread ([this, i] () { worker_loop (i); });
+    }
+}
+
+WorkerPool::~WorkerPool () { stop (); }
+
+bool
+WorkerPool::post (size_t shard, Task task)
+{
+  Worker &worker = *workers_[shard % workers_.size ()];
+
+  {
+    std::lock_guard<std::mutex> lock (worker.mutex);
+    if (stopping_ || worker.queue.size () >= queue_capacity_)
+      {
+        dropped_++;
+        return false;
+      }
+    worker.queue.push_back (std::move (task));
+  }
+
+  worker.cv.notify_one ();
+  return true;
+}
+
+void
+WorkerPool::stop ()
+{
+  if (stopping_.exchange (true))
+    {
+      return;
+    }
+
+  for (auto &worker : workers_)
+    {
+      {
+        std::lock_guard<std::mutex> lock (worker->mutex);
+      }
+      worker->cv.notify_all ();
+    }
+
+  for (auto &worker : workers_)
+    {
+      if (worker->thread.joinable ())
+        {
+          worker->thread.join ();
+        }
+    }
+}
+
+void
+WorkerPool::worker_loop (size_t index)
+{
+  Worker &worker = *workers_[index];
+  if (init_)
+    {
+      init_ (index);
+    }
+
+  for (;;)
+    {
+      Task task;
+      {
+        std::unique_lock<std::mutex> lock (worker.mutex);
+        worker.cv.wait (lock, [&] () {
+          return stopping_.load () || !worker.queue.empty ();
+        });
+
+        // Drain the queue before exiting
+        if (worker.queue.empty ())
+          {
+            return;
+          }
+
+        task = std::move (worker.queue.front ());
+        worker.queue.pop_front ();
+      }
+
+      task (index);
+    }
+}
+
+} // namespace jettison
@@ -0,0 +1,98 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 Jettison Project Team
+
+#ifndef WORKER_POOL_H
+#define WORKER_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace jettison
+{
+
+/**
+ * @brief Fixed pool of worker threads with one queue per worker
+ *
+ * Tasks are routed to a worker by shard key, so all tasks posted with the
+ * same shard (e.g., the same connection) run in order on the same thread
+ * and may use per-worker state without locking. Queues are bounded: when
+ * a worker falls behind, new tasks are dropped and counted rather than
+ * stalling the producer (the WebSocket event loop).
+ */
+class WorkerPool
+{
+public:
+  using Task = std::function<void (size_t worker)>;
+  using ThreadInit = std::function<void (size_t worker)>;
+
+  /**
+   * @brief Start worker threads
+   * @param threads Number of worker threads (at least 1)
+   * @param queue_capacity Maximum queued tasks per worker
+   * @param init Optional function run first on each worker thread (e.g.
+   *             CPU pinning), before it takes any task
+   */
+  explicit WorkerPool (size_t threads, size_t queue_capacity = 1024,
+                       ThreadInit init = nullptr);
+  ~WorkerPool ();
+
+  // Non-copyable, non-movable
+  WorkerPool (const WorkerPool &) = delete;
+  WorkerPool &operator= (const WorkerPool &) = delete;
+  WorkerPool (WorkerPool &&) = delete;
+  WorkerPool &operator= (WorkerPool &&) = delete;
+
+  /**
+   * @brief Queue a task on the worker owning a shard
+   * @param shard Shard key (worker = shard % size())
+   * @param task Task to run; receives the worker index
+   * @return true if queued, false if the worker's queue was full
+   */
+  bool post (size_t shard, Task task);
+
+  /**
+   * @brief Run remaining queued tasks and join all threads
+   */
+  void stop ();
+
+  /**
+   * @brief Get the number of worker threads
+   * @return Worker count
+   */
+  size_t size () const { return workers_.size (); }
+
+  /**
+   * @brief Get the number of tasks dropped because a queue was full
+   * @return Dropped task count
+   */
+  uint64_t dropped_count () const { return dropped_.load (); }
+
+private:
+  struct Worker
+  {
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::deque<Task> queue;
+    std::thread thread;
+  };
+
+  void worker_loop (size_t index);
+
+  std::vector<std::unique_ptr<Worker>> workers_;
+  ThreadInit init_;
+  size_t queue_capacity_;
+  std::atomic<bool> stopping_;
+  std::atomic<uint64_t> dropped_;
+};
+
+} // namespace jettison
+
+#endif // WORKER_POOL_H
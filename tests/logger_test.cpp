@@ -0,0 +1,140 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 Jettison Project Team
+
+// Checks the Logger's ring accounting: with small rings flooded from
+// several threads, every message is either written or counted as
+// dropped, oversized messages are counted and reported by a warning,
+// and messages logged while stopped are written synchronously.
+//
+// Usage: logger_test
+
+#include "logger.h"
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+using namespace jettison;
+
+namespace
+{
+
+constexpr size_t RING_BYTES = 4096;
+constexpr size_t THREADS = 4;
+constexpr uint64_t MESSAGES = 20000; // Per thread
+constexpr uint64_t OVERSIZED = 25;   // Per thread
+
+const std::string_view WARNING_PREFIX = "Logger: dropped ";
+
+int failures = 0;
+
+void
+check (bool condition, const std::string &what)
+{
+  if (!condition)
+    {
+      std::cerr << "FAILED: " << what << "\n";
+      failures++;
+    }
+}
+
+/**
+ * @brief Lines received by the sink
+ */
+struct Received
+{
+  std::atomic<uint64_t> messages{ 0 };
+  std::atomic<uint64_t> reported_oversized{ 0 }; // Sum over the warnings
+  std::atomic<uint64_t> warnings{ 0 };
+};
+
+LogStats
+operator- (const LogStats &a, const LogStats &b)
+{
+  return { a.written - b.written, a.dropped - b.dropped,
+           a.oversized - b.oversized };
+}
+
+} // namespace
+
+int
+main ()
+{
+  Logger &logger = Logger::instance ();
+  Received received;
+  logger.set_sink ([&received] (LogLevel level, std::string_view line) {
+    if (level == LogLevel::Warning && line.starts_with (WARNING_PREFIX))
+      {
+        received.warnings++;
+        received.reported_oversized += std::stoull (
+            std::string (line.substr (WARNING_PREFIX.size ())));
+        return;
+      }
+    received.messages++;
+  });
+
+  // Stopped: written in place, nothing dropped
+  LogStats before = logger.stats ();
+  for (uint64_t i = 0; i < 100; ++i)
+    {
+      log_info ("sync message ", i);
+    }
+  LogStats delta = logger.stats () - before;
+  check (delta.written == 100 && received.messages == 100,
+         "stopped logger writes every message");
+  check (delta.dropped == 0, "stopped logger drops nothing");
+
+  // Started with small rings: flood them from several threads
+  received.messages = 0;
+  logger.start (RING_BYTES);
+  const size_t max_record = logger.max_record_bytes ();
+  before = logger.stats ();
+  const std::string padding (64, 'x');
+  const std::string huge (max_record, 'y');
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < THREADS; ++t)
+    {
+      threads.emplace_back ([&] {
+        for (uint64_t i = 0; i < MESSAGES; ++i)
+          {
+            log_info ("message ", i, " of ", MESSAGES, ' ', padding);
+            if (i % (MESSAGES / OVERSIZED) == 0)
+              {
+                log_info ("oversized ", huge);
+              }
+          }
+      });
+    }
+  for (auto &thread : threads)
+    {
+      thread.join ();
+    }
+  logger.stop ();
+  delta = logger.stats () - before;
+
+  const uint64_t logged = THREADS * (MESSAGES + OVERSIZED);
+  check (received.messages + delta.dropped == logged,
+         "written + dropped == logged (" + std::to_string (received.messages)
+             + " + " + std::to_string (delta.dropped) + " != "
+             + std::to_string (logged) + ")");
+  check (delta.written == received.messages + received.warnings,
+         "written counts every line handed to the sink");
+  check (delta.oversized == THREADS * OVERSIZED,
+         "oversized count (" + std::to_string (delta.oversized) + ")");
+  check (received.reported_oversized == delta.oversized,
+         "every oversized message is reported by a warning");
+
+  if (failures > 0)
+    {
+      std::cerr << failures << " check(s) failed\n";
+      return EXIT_FAILURE;
+    }
+  std::cout << "Logged " << logged << " messages: " << received.messages
+            << " written, " << delta.dropped << " dropped ("
+            << delta.oversized << " oversized)\n";
+  return EXIT_SUCCESS;
+}